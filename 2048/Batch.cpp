@@ -0,0 +1,181 @@
+#include "Batch.h"
+#include "Grid.h"
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/* Reads whitespace separated integers through a block buffer */
+class IntReader {
+public:
+    explicit IntReader(FILE* in) : m_in(in), m_pos(0), m_size(0), m_eof(false) { m_buffer[0] = '\0'; }
+    bool read(int& x) {
+        /// false at the end of the input
+        for (;;) {
+            if (m_size - m_pos < LOOKAHEAD) refill();
+            while (m_pos < m_size && m_buffer[m_pos] != '-' && !isDigit(m_buffer[m_pos])) ++m_pos;
+            if (m_pos < m_size) break;
+            if (m_eof) return false;
+        }
+        if (m_size - m_pos < LOOKAHEAD) refill();
+        // a number fits into the lookahead, the buffer ends with a '\0' sentinel
+        const char* p = &m_buffer[m_pos];
+        bool negative = *p == '-';
+        if (negative) ++p;
+        unsigned int u = 0;
+        for (; isDigit(*p); ++p) u = u * 10 + (*p - '0');
+        x = negative ? -static_cast<int>(u) : static_cast<int>(u);
+        m_pos = p - m_buffer.data();
+        return true;
+    }
+private:
+    static constexpr int BUFFER_SIZE = 1 << 20;
+    static constexpr int LOOKAHEAD = 64;
+    static bool isDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+    void refill() {
+        /// moves the unread characters to the front and appends the next block
+        if (m_eof) return;
+        std::copy(m_buffer.begin() + m_pos, m_buffer.begin() + m_size, m_buffer.begin());
+        m_size -= m_pos;
+        m_pos = 0;
+        size_t nbrRead = fread(m_buffer.data() + m_size, 1, BUFFER_SIZE - m_size, m_in);
+        m_eof = nbrRead == 0;
+        m_size += nbrRead;
+        m_buffer[m_size] = '\0';
+    }
+    FILE* m_in;
+    int m_pos;
+    int m_size;
+    bool m_eof;
+    std::vector<char> m_buffer = std::vector<char>(BUFFER_SIZE + 1);
+};
+
+/// writes x at 'out', returns the end of the written characters
+char* writeInt(char* out, int x) {
+    char digits[12];
+    int nbrDigits = 0;
+    unsigned int u = x < 0 ? -static_cast<unsigned int>(x) : x;
+    do {
+        digits[nbrDigits++] = '0' + u % 10;
+        u /= 10;
+    } while (u);
+    if (x < 0) *out++ = '-';
+    while (nbrDigits) *out++ = digits[--nbrDigits];
+    return out;
+}
+
+/// decimal text of the tile of each exponent of a Bitboard
+struct TileText {
+    char chars[8];
+    int length;
+};
+
+const std::array<TileText, 16>& tileTexts() {
+    static const std::array<TileText, 16> texts = []() {
+        std::array<TileText, 16> t;
+        for (int e = 0; e < 16; ++e) {
+            t[e].length = writeInt(t[e].chars, e == 0 ? 0 : 1 << e) - t[e].chars;
+        }
+        return t;
+    }();
+    return texts;
+}
+
+constexpr int MAX_TILE_CHARS = 12; // sign, 10 digits and separator
+
+/// moves records [begin, end) of 'values' (N*N tiles and the move per record) and formats them
+template <int N>
+int64_t moveRecords(const std::vector<int>& values, int begin, int end, std::vector<char>& out, size_t& outSize) {
+    constexpr int nbrTiles = N * N;
+    constexpr int recordSize = nbrTiles + 1;
+    int64_t nbrValueMoves = 0;
+    out.resize(std::max<size_t>(out.size(), static_cast<size_t>(end - begin) * nbrTiles * MAX_TILE_CHARS));
+    char* o = out.data();
+    for (int r = begin; r < end; ++r) {
+        const int* record = &values[static_cast<size_t>(r) * recordSize];
+        Tiles<N> tiles;
+        std::copy(record, record + nbrTiles, tiles.begin());
+        Move m = static_cast<Move>(record[nbrTiles]);
+        if constexpr (IS_PACKED<N>) {
+            PackedWord<N> packed;
+            if (pack<N>(tiles, packed)) {
+                // formatted from the exponents, tile k is at bits 4k
+                PackedWord<N> moved = movePacked<N>(packed, m);
+                for (int k = 0; k < nbrTiles; ++k, moved >>= 4) {
+                    const TileText& text = tileTexts()[static_cast<int>(moved) & 0xF];
+                    std::copy(text.chars, text.chars + text.length, o);
+                    o += text.length;
+                    *o++ = k % N == N - 1 ? '\n' : ' ';
+                }
+                continue;
+            }
+        }
+        moveValues<N>(tiles, m);
+        ++nbrValueMoves;
+        for (int k = 0; k < nbrTiles; ++k) {
+            o = writeInt(o, tiles[k]);
+            *o++ = k % N == N - 1 ? '\n' : ' ';
+        }
+    }
+    outSize = o - out.data();
+    return nbrValueMoves;
+}
+
+template <int N>
+BatchStats runBatchOf(FILE* in, FILE* out, int nbrThreads, int chunkSize) {
+    constexpr int recordSize = N * N + 1;
+    IntReader reader(in);
+    std::vector<int> values(static_cast<size_t>(chunkSize) * recordSize);
+    std::vector<std::vector<char>> buffers(nbrThreads);
+    std::vector<size_t> bufferSizes(nbrThreads, 0);
+    BatchStats stats{0, 0};
+    bool endOfInput = false;
+    while (!endOfInput) {
+        int nbrRecords = 0;
+        while (nbrRecords < chunkSize) {
+            int* record = &values[static_cast<size_t>(nbrRecords) * recordSize];
+            int k = 0;
+            while (k < recordSize && reader.read(record[k])) ++k;
+            if (k < recordSize) {
+                endOfInput = true; // an incomplete last record is ignored
+                break;
+            }
+            ++nbrRecords;
+        }
+        // contiguous slices, so that the buffers are written in input order
+        int sliceSize = (nbrRecords + nbrThreads - 1) / nbrThreads;
+        std::vector<int64_t> nbrValueMoves(nbrThreads, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < nbrThreads; ++t) {
+            int begin = std::min(nbrRecords, t * sliceSize), end = std::min(nbrRecords, begin + sliceSize);
+            auto work = [&, t, begin, end]() { nbrValueMoves[t] = moveRecords<N>(values, begin, end, buffers[t], bufferSizes[t]); };
+            if (t + 1 == nbrThreads) {
+                work(); // the calling thread takes the last slice
+            } else {
+                threads.emplace_back(work);
+            }
+        }
+        for (std::thread& thread : threads) thread.join();
+        for (int t = 0; t < nbrThreads; ++t) {
+            fwrite(buffers[t].data(), 1, bufferSizes[t], out);
+            stats.nbrValueMoves += nbrValueMoves[t];
+        }
+        stats.nbrRecords += nbrRecords;
+    }
+    fflush(out);
+    return stats;
+}
+
+}
+
+BatchStats runBatch(FILE* in, FILE* out, int nbrThreads, int dim, int chunkSize) {
+    if (nbrThreads <= 0) {
+        nbrThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    BatchStats stats{-1, 0};
+    withDim(dim, [&](auto n) { stats = runBatchOf<decltype(n)::value>(in, out, nbrThreads, chunkSize); });
+    return stats;
+}
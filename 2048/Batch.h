@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+/* Streaming batch mode: the input is a sequence of records as in the single mode (dim rows of dim
+ * tiles, then the move), the output the moved boards in input order (dim lines per record).
+ * Records are read through a block buffer in chunks of 'chunkSize', each chunk is moved and formatted
+ * by 'nbrThreads' threads (0: hardware concurrency) into per thread buffers, which are written in order.
+ * The dimension is dispatched once per run, all records are moved by the kernels of Grid.h for that size.
+ */
+struct BatchStats {
+    int64_t nbrRecords;     // -1 if dim is not supported
+    int64_t nbrValueMoves;  // records whose tiles did not fit into a PackedWord (see Grid.h)
+};
+
+BatchStats runBatch(FILE* in, FILE* out, int nbrThreads, int dim = 4, int chunkSize = 1 << 16);
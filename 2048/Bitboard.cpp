@@ -0,0 +1,86 @@
+#include "Bitboard.h"
+
+#include <array>
+
+namespace {
+
+using Row = uint16_t;
+
+/* Moved rows for each of the 65536 rows, filled once on first use */
+struct RowTables {
+    std::array<Row, 65536> left;
+    std::array<Row, 65536> right;
+    RowTables() {
+        for (int row = 0; row < 65536; ++row) {
+            std::array<int, 4> tiles;
+            for (int j = 0; j < 4; ++j) tiles[j] = (row >> (4 * j)) & 0xF;
+            left[row] = pack(moveLeft(tiles));
+            std::array<int, 4> reversed = {tiles[3], tiles[2], tiles[1], tiles[0]};
+            std::array<int, 4> moved = moveLeft(reversed);
+            right[row] = pack({moved[3], moved[2], moved[1], moved[0]});
+        }
+    }
+    static std::array<int, 4> moveLeft(const std::array<int, 4>& tiles) {
+        /// slides the tiles to column 0, equal neighbours merge once (exponent + 1)
+        std::array<int, 4> moved = {0, 0, 0, 0};
+        int target = 0;
+        bool canMerge = false; // whether moved[target-1] may still merge
+        for (int tile : tiles) {
+            if (tile == 0) continue;
+            if (canMerge && moved[target - 1] == tile) {
+                // exponents of 15 only occur in unused rows (see MAX_PACKED_EXPONENT)
+                moved[target - 1] = (tile + 1) & 0xF;
+                canMerge = false;
+            } else {
+                moved[target++] = tile;
+                canMerge = true;
+            }
+        }
+        return moved;
+    }
+    static Row pack(const std::array<int, 4>& tiles) {
+        return tiles[0] | tiles[1] << 4 | tiles[2] << 8 | tiles[3] << 12;
+    }
+};
+
+const RowTables& rowTables() {
+    static const RowTables tables;
+    return tables;
+}
+
+Bitboard moveRows(Bitboard b, const std::array<Row, 65536>& table) {
+    return static_cast<Bitboard>(table[b & 0xFFFF])
+        | static_cast<Bitboard>(table[(b >> 16) & 0xFFFF]) << 16
+        | static_cast<Bitboard>(table[(b >> 32) & 0xFFFF]) << 32
+        | static_cast<Bitboard>(table[b >> 48]) << 48;
+}
+
+}
+
+Bitboard transpose(Bitboard b) {
+    // swap the off-diagonal tiles of the 2x2 blocks, then the off-diagonal 2x2 blocks
+    Bitboard a1 = b & 0xF0F00F0FF0F00F0FULL;
+    Bitboard a2 = b & 0x0000F0F00000F0F0ULL;
+    Bitboard a3 = b & 0x0F0F00000F0F0000ULL;
+    Bitboard a = a1 | (a2 << 12) | (a3 >> 12);
+    Bitboard b1 = a & 0xFF00FF0000FF00FFULL;
+    Bitboard b2 = a & 0x00FF00FF00000000ULL;
+    Bitboard b3 = a & 0x00000000FF00FF00ULL;
+    return b1 | (b2 >> 24) | (b3 << 24);
+}
+
+Bitboard applyMove(Bitboard b, Move m) {
+    const RowTables& tables = rowTables();
+    switch (m) {
+        case Move::LEFT:
+            return moveRows(b, tables.left);
+        case Move::RIGHT:
+            return moveRows(b, tables.right);
+        case Move::UP:
+            // columns become rows with row 0 in column 0
+            return transpose(moveRows(transpose(b), tables.left));
+        case Move::DOWN:
+            return transpose(moveRows(transpose(b), tables.right));
+    }
+    return b;
+}
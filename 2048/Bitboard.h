@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Board.h"
+
+#include <cstdint>
+
+/* 4x4 board packed into 64 bits: 4 bits per tile holding log2 of the value (0: empty),
+ * row i in bits 16i to 16i+15, column j of a row in bits 4j to 4j+3.
+ * Rows are moved by lookups in precomputed tables of all 65536 rows, columns by transposing the board.
+ * Boards of tile values are converted by pack<4>/unpack<4> (Grid.h).
+ */
+using Bitboard = uint64_t;
+
+constexpr int MAX_PACKED_EXPONENT = 14; // tiles up to 16384, so that merged tiles (32768) still fit into 4 bits
+
+Bitboard transpose(Bitboard b);
+
+/// board after moving all tiles in direction m (merged tiles do not merge again in the same move)
+Bitboard applyMove(Bitboard b, Move m);
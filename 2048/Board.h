@@ -0,0 +1,8 @@
+#pragma once
+
+enum class Move {
+    LEFT = 0,
+    UP, 
+    RIGHT,
+    DOWN
+};
@@ -0,0 +1,199 @@
+#include "Expectimax.h"
+
+#include <array>
+#include <cmath>
+#include <random>
+
+namespace {
+
+/* The heuristic constants and the row rating/score tables below follow the expectimax AI of
+ * Robert Xiao, https://github.com/nneonneo/2048-ai (2048.cpp, init_tables), MIT license,
+ * Copyright (c) 2014 Robert Xiao.
+ */
+constexpr double LOST_PENALTY = 200000.0;
+constexpr double MONOTONICITY_POWER = 4.0;
+constexpr double MONOTONICITY_WEIGHT = 47.0;
+constexpr double SUM_POWER = 3.5;
+constexpr double SUM_WEIGHT = 11.0;
+constexpr double MERGES_WEIGHT = 700.0;
+constexpr double EMPTY_WEIGHT = 270.0;
+
+/* Rating and score of each of the 65536 rows (4 exponents of 4 bits, see Bitboard.h) */
+struct RowRatings {
+    std::array<double, 65536> rating;
+    std::array<int, 65536> score; // points to build the tiles of the row from 2's
+    RowRatings() {
+        for (int row = 0; row < 65536; ++row) {
+            std::array<int, 4> tiles;
+            for (int j = 0; j < 4; ++j) tiles[j] = (row >> (4 * j)) & 0xF;
+            double sum = 0.0;
+            int empty = 0, merges = 0, previous = 0, counter = 0;
+            score[row] = 0;
+            for (int tile : tiles) {
+                sum += std::pow(tile, SUM_POWER);
+                if (tile == 0) {
+                    ++empty;
+                    continue;
+                }
+                score[row] += (tile - 1) * (1 << tile);
+                if (tile == previous) {
+                    ++counter;
+                } else if (counter > 0) {
+                    merges += 1 + counter;
+                    counter = 0;
+                }
+                previous = tile;
+            }
+            if (counter > 0) merges += 1 + counter;
+            // tiles should increase or decrease along the row, larger tiles count more
+            double increasing = 0.0, decreasing = 0.0;
+            for (int j = 1; j < 4; ++j) {
+                double a = std::pow(tiles[j - 1], MONOTONICITY_POWER), b = std::pow(tiles[j], MONOTONICITY_POWER);
+                if (tiles[j - 1] > tiles[j]) {
+                    increasing += a - b;
+                } else {
+                    decreasing += b - a;
+                }
+            }
+            rating[row] = LOST_PENALTY + EMPTY_WEIGHT * empty + MERGES_WEIGHT * merges
+                - MONOTONICITY_WEIGHT * std::min(increasing, decreasing) - SUM_WEIGHT * sum;
+        }
+    }
+};
+
+const RowRatings& rowRatings() {
+    static const RowRatings ratings;
+    return ratings;
+}
+
+template <typename T>
+T sumRows(Bitboard b, const std::array<T, 65536>& table) {
+    return table[b & 0xFFFF] + table[(b >> 16) & 0xFFFF] + table[(b >> 32) & 0xFFFF] + table[b >> 48];
+}
+
+/// bit 4k is set if tile k is empty
+Bitboard emptyTiles(Bitboard b) {
+    b |= (b >> 2);
+    b |= (b >> 1);
+    return ~b & 0x1111111111111111ULL;
+}
+
+int maxExponent(Bitboard b) {
+    int m = 0;
+    for (; b; b >>= 4) m = std::max(m, static_cast<int>(b & 0xF));
+    return m;
+}
+
+constexpr Move MOVES[4] = {Move::LEFT, Move::UP, Move::RIGHT, Move::DOWN};
+
+}
+
+double evaluate(Bitboard b) {
+    const RowRatings& ratings = rowRatings();
+    return sumRows(b, ratings.rating) + sumRows(transpose(b), ratings.rating);
+}
+
+ExpectimaxAI::ExpectimaxAI(const ExpectimaxParams& params)
+        : m_params(params), m_table(1 << TABLE_BITS, Entry{0, 0, 0, 0.0}), m_generation(0),
+          m_aborted(false), m_lastDepth(0), m_nbrNodes(0), m_nextClockCheck(0) {
+    rowRatings();
+}
+
+bool ExpectimaxAI::outOfTime() {
+    // the clock is read after every 4096 nodes
+    if (m_params.timeBudget > 0.0 && m_nbrNodes >= m_nextClockCheck) {
+        m_nextClockCheck = m_nbrNodes + 4096;
+        m_aborted = std::chrono::steady_clock::now() > m_deadline;
+    }
+    return m_aborted;
+}
+
+double ExpectimaxAI::maxNode(Bitboard b, int depth, double probability) {
+    double best = 0.0; // lost
+    for (Move m : MOVES) {
+        Bitboard next = applyMove(b, m);
+        if (next != b) {
+            best = std::max(best, chanceNode(next, depth, probability));
+        }
+    }
+    return best;
+}
+
+double ExpectimaxAI::chanceNode(Bitboard b, int depth, double probability) {
+    ++m_nbrNodes;
+    if (depth == 0 || probability < m_params.minProbability || outOfTime()) {
+        return evaluate(b);
+    }
+    Entry& entry = m_table[(b * 0x9E3779B97F4A7C15ULL) >> (64 - TABLE_BITS)];
+    if (entry.generation == m_generation && entry.board == b && entry.depth >= depth) {
+        return entry.value;
+    }
+    Bitboard empty = emptyTiles(b);
+    int nbrEmpty = __builtin_popcountll(empty);
+    double cellProbability = probability / nbrEmpty;
+    double value = 0.0;
+    for (Bitboard e = empty; e; e &= e - 1) {
+        Bitboard tile = e & -e; // exponent 1 at the empty tile
+        value += 0.9 * maxNode(b | tile, depth - 1, cellProbability * 0.9);
+        value += 0.1 * maxNode(b | (tile << 1), depth - 1, cellProbability * 0.1);
+    }
+    value /= nbrEmpty;
+    if (!m_aborted) {
+        entry = {b, m_generation, depth, value}; // 'entry' may have been replaced by the children, it is overwritten
+    }
+    return value;
+}
+
+bool ExpectimaxAI::bestMove(Bitboard b, Move& best) {
+    ++m_generation; // starts at 1, unused entries have generation 0
+    m_aborted = false;
+    m_deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(m_params.timeBudget));
+    bool found = false;
+    m_lastDepth = 0;
+    for (int depth = 1; depth <= m_params.maxDepth; ++depth) {
+        double bestValue = -1.0;
+        Move bestOfDepth = Move::LEFT;
+        for (Move m : MOVES) {
+            Bitboard next = applyMove(b, m);
+            if (next == b) continue;
+            double value = chanceNode(next, depth, 1.0);
+            if (value > bestValue) {
+                bestValue = value;
+                bestOfDepth = m;
+            }
+        }
+        if (bestValue < 0.0) {
+            return false;
+        }
+        if (m_aborted && found) {
+            break; // keep the move of the last complete depth
+        }
+        best = bestOfDepth;
+        found = true;
+        m_lastDepth = depth;
+        if (m_aborted) break;
+    }
+    return found;
+}
+
+GameResult playGame(ExpectimaxAI& ai, unsigned int seed) {
+    std::mt19937 engine(seed);
+    auto spawn = [&engine](Bitboard b, int64_t& penalty) {
+        Bitboard empty = emptyTiles(b);
+        int k = std::uniform_int_distribution<int>(0, __builtin_popcountll(empty) - 1)(engine);
+        for (; k > 0; --k) empty &= empty - 1;
+        bool four = std::uniform_int_distribution<int>(0, 9)(engine) == 0;
+        penalty += four ? 4 : 0; // a spawned 4 was not built from 2's
+        return b | ((empty & -empty) << four);
+    };
+    int64_t penalty = 0;
+    Bitboard b = spawn(spawn(0, penalty), penalty);
+    int nbrMoves = 0;
+    Move m;
+    while (maxExponent(b) < 15 && ai.bestMove(b, m)) {
+        b = spawn(applyMove(b, m), penalty);
+        ++nbrMoves;
+    }
+    return {nbrMoves, 1 << maxExponent(b), sumRows(b, rowRatings().score) - penalty};
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Bitboard.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/* Expectimax search on bitboards.
+ * Max nodes choose one of the moves that change the board, chance nodes average over all empty
+ * cells the spawn of a 2 (probability 0.9) or a 4 (0.1). Leaves (depth reached, or a path probability
+ * below 'minProbability') are rated by a heuristic: the sum over all rows and columns of a
+ * precomputed row rating (empty cells, possible merges, monotonicity, large tiles).
+ * Chance nodes are cached in a transposition table: a direct mapped table of 2^18 entries
+ * (board, value, depth it was searched with), entries of earlier moves are invalidated by a generation counter.
+ * The depth is deepened iteratively until 'maxDepth' or until 'timeBudget' runs out, a depth that
+ * is interrupted by the budget is discarded.
+ */
+
+struct ExpectimaxParams {
+    int maxDepth = 2;               // moves of the player to look ahead
+    double timeBudget = 0.0;        // seconds per move, 0: no limit
+    double minProbability = 1e-4;   // path probability below which chance nodes are not expanded
+};
+
+class ExpectimaxAI {
+public:
+    explicit ExpectimaxAI(const ExpectimaxParams& params);
+    bool bestMove(Bitboard b, Move& best);
+        /// false if no move changes the board (game over)
+    int lastDepth() const { return m_lastDepth; }   // depth of the last bestMove
+    int64_t nbrNodes() const { return m_nbrNodes; } // nodes searched in total
+private:
+    struct Entry {
+        Bitboard board;
+        uint32_t generation; // bestMove call that stored the entry
+        int depth;
+        double value;
+    };
+    static constexpr int TABLE_BITS = 18;
+    double maxNode(Bitboard b, int depth, double probability);
+    double chanceNode(Bitboard b, int depth, double probability);
+    bool outOfTime();
+    ExpectimaxParams m_params;
+    std::vector<Entry> m_table;
+    uint32_t m_generation;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_aborted;
+    int m_lastDepth;
+    int64_t m_nbrNodes;
+    int64_t m_nextClockCheck; // value of m_nbrNodes at which outOfTime reads the clock
+};
+
+/// rating of a board by the heuristic of the leaves
+double evaluate(Bitboard b);
+
+struct GameResult {
+    int nbrMoves;
+    int maxTile;
+    int64_t score;  // sum of the merged tiles
+};
+
+/* Plays a game from two random tiles until no move is possible (or a 32768 tile appears,
+ * the largest tile of the bitboard) with the tiles spawned by a random engine seeded with 'seed' */
+GameResult playGame(ExpectimaxAI& ai, unsigned int seed);
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Bitboard.h"
+#include "Board.h"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+/* Boards of N x N tiles with N fixed at compile time, so that the loops over the lines and tiles
+ * of a move are unrolled for each size.
+ * Tiles<N> holds the values in row major order. While all tiles are 0 or powers of two up to
+ * 2^MAX_PACKED_EXPONENT, a board is moved as PackedWord<N>: 4 bit exponents with tile k at bits 4k,
+ * 64 bits up to 4x4 (the 4x4 word is a Bitboard and moved with its row tables), 128 bits up to 5x5.
+ * Larger boards and other tiles are moved on the values.
+ */
+constexpr int MIN_DIM = 2;
+constexpr int MAX_DIM = 8;
+
+template <int N>
+using Tiles = std::array<int, N * N>;
+
+template <int N>
+constexpr bool IS_PACKED = 4 * N * N <= 128;
+
+template <int N>
+using PackedWord = std::conditional_t<4 * N * N <= 64, uint64_t,
+                                      std::conditional_t<IS_PACKED<N>, unsigned __int128, void>>;
+
+/// row major index of position p of line r (a row for LEFT and RIGHT, a column for UP and DOWN),
+/// tiles slide towards position 0
+template <int N, Move M>
+constexpr int cellIndex(int r, int p) {
+    switch (M) {
+        case Move::LEFT: return r * N + p;
+        case Move::RIGHT: return r * N + N - 1 - p;
+        case Move::UP: return p * N + r;
+        case Move::DOWN: return (N - 1 - p) * N + r;
+    }
+    return 0;
+}
+
+/// slides the tiles of a line to position 0, equal neighbours merge once ('merge' maps a tile to the merged tile)
+template <int N, typename Merge>
+void slideLine(std::array<int, N>& line, Merge merge) {
+    std::array<int, N> moved{};
+    int target = 0;
+    bool canMerge = false; // whether moved[target-1] may still merge
+    for (int p = 0; p < N; ++p) {
+        int tile = line[p];
+        if (tile == 0) continue;
+        if (canMerge && moved[target - 1] == tile) {
+            moved[target - 1] = merge(tile);
+            canMerge = false;
+        } else {
+            moved[target++] = tile;
+            canMerge = true;
+        }
+    }
+    line = moved;
+}
+
+/// calls f(Move constant) for the move m, so that the move is a template argument of the kernels
+template <typename F>
+void withMove(Move m, F f) {
+    switch (m) {
+        case Move::LEFT: f(std::integral_constant<Move, Move::LEFT>()); break;
+        case Move::UP: f(std::integral_constant<Move, Move::UP>()); break;
+        case Move::RIGHT: f(std::integral_constant<Move, Move::RIGHT>()); break;
+        case Move::DOWN: f(std::integral_constant<Move, Move::DOWN>()); break;
+    }
+}
+
+/// calls f(dimension constant) for dim in [MIN_DIM, MAX_DIM], returns false for other dimensions
+template <typename F>
+bool withDim(int dim, F f) {
+    switch (dim) {
+        case 2: f(std::integral_constant<int, 2>()); return true;
+        case 3: f(std::integral_constant<int, 3>()); return true;
+        case 4: f(std::integral_constant<int, 4>()); return true;
+        case 5: f(std::integral_constant<int, 5>()); return true;
+        case 6: f(std::integral_constant<int, 6>()); return true;
+        case 7: f(std::integral_constant<int, 7>()); return true;
+        case 8: f(std::integral_constant<int, 8>()); return true;
+    }
+    return false;
+}
+
+template <int N>
+void moveValues(Tiles<N>& tiles, Move m) {
+    /// moves tiles of any value (equal values merge into their sum)
+    withMove(m, [&tiles](auto move) {
+        constexpr Move M = decltype(move)::value;
+        for (int r = 0; r < N; ++r) {
+            std::array<int, N> line;
+            for (int p = 0; p < N; ++p) line[p] = tiles[cellIndex<N, M>(r, p)];
+            slideLine<N>(line, [](int tile) { return 2 * tile; });
+            for (int p = 0; p < N; ++p) tiles[cellIndex<N, M>(r, p)] = line[p];
+        }
+    });
+}
+
+template <int N>
+bool pack(const Tiles<N>& tiles, PackedWord<N>& packed) {
+    /// false if a tile is not 0 or a power of two up to 2^MAX_PACKED_EXPONENT
+    packed = 0;
+    for (int k = 0; k < N * N; ++k) {
+        int value = tiles[k];
+        if (value == 0) continue;
+        if (value < 2 || (value & (value - 1)) || value > (1 << MAX_PACKED_EXPONENT)) {
+            return false;
+        }
+        packed |= static_cast<PackedWord<N>>(__builtin_ctz(value)) << (4 * k);
+    }
+    return true;
+}
+
+template <int N>
+void unpack(PackedWord<N> packed, Tiles<N>& tiles) {
+    for (int k = 0; k < N * N; ++k) {
+        int exponent = static_cast<int>(packed >> (4 * k)) & 0xF;
+        tiles[k] = exponent ? 1 << exponent : 0;
+    }
+}
+
+template <int N>
+PackedWord<N> movePacked(PackedWord<N> packed, Move m) {
+    if constexpr (N == 4) {
+        return applyMove(packed, m);
+    } else {
+        PackedWord<N> moved = 0;
+        withMove(m, [&](auto move) {
+            constexpr Move M = decltype(move)::value;
+            for (int r = 0; r < N; ++r) {
+                std::array<int, N> line;
+                for (int p = 0; p < N; ++p) line[p] = static_cast<int>(packed >> (4 * cellIndex<N, M>(r, p))) & 0xF;
+                slideLine<N>(line, [](int exponent) { return exponent + 1; });
+                for (int p = 0; p < N; ++p) moved |= static_cast<PackedWord<N>>(line[p]) << (4 * cellIndex<N, M>(r, p));
+            }
+        });
+        return moved;
+    }
+}
+
+template <int N>
+bool moveTiles(Tiles<N>& tiles, Move m) {
+    /// moves the tiles, returns false if they did not fit into a PackedWord and were moved as values
+    if constexpr (IS_PACKED<N>) {
+        PackedWord<N> packed;
+        if (pack<N>(tiles, packed)) {
+            unpack<N>(movePacked<N>(packed, m), tiles);
+            return true;
+        }
+    }
+    moveValues<N>(tiles, m);
+    return false;
+}
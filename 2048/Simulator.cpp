@@ -0,0 +1,49 @@
+#include "Simulator.h"
+#include "Grid.h"
+
+namespace {
+
+template <int N>
+bool parseInput(std::istream& in, Tiles<N>& tiles, Move& move) {
+    for (int& tile : tiles) {
+        in >> tile;
+    }
+
+    // read move:
+    int m;
+    in >> m;
+    move = static_cast<Move>(m);
+    return static_cast<bool>(in);
+}
+
+template <int N>
+void printOutput(std::ostream& out, const Tiles<N>& tiles) {
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            out << tiles[i * N + j];
+            if (j != N-1) {
+                out << " ";
+            } else {
+                out << std::endl;
+            }
+        }
+    }
+}
+
+}
+
+bool simulate(std::istream& in, std::ostream& out, int dim) {
+    bool ok = false;
+    bool supported = withDim(dim, [&](auto n) {
+        constexpr int N = decltype(n)::value;
+        Tiles<N> tiles;
+        Move move;
+        ok = parseInput<N>(in, tiles, move);
+        if (ok) {
+            // determine state after performing move on board
+            moveTiles<N>(tiles, move);
+            printOutput<N>(out, tiles);
+        }
+    });
+    return supported && ok;
+}
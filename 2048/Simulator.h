@@ -0,0 +1,8 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+
+/// reads a board of dim rows of dim tiles and the move from 'in' and writes the board after the move to 'out',
+/// returns false if dim is not in [MIN_DIM, MAX_DIM] (see Grid.h) or the input is incomplete
+bool simulate(std::istream& in, std::ostream& out, int dim);
@@ -1,133 +1,54 @@
-#include <iostream>
-#include <vector>
-#include <optional>
-#include <set>
-
-int DIM = 4; 
-using Board = std::vector<std::vector<int>>;
-using MSet = std::set<std::pair<int,int>>; // collection of merged tiles
-
-enum class Move {
-    LEFT = 0,
-    UP, 
-    RIGHT,
-    DOWN
-};
-
-void parseInput(Board& board, Move& move) {
-    int gameDim = DIM; // 4 by 4 game board
-    while (gameDim--) {
-        int a, b, c, d;
-        std::cin >> a >> b >> c >> d;
-        std::vector<int> row = {a, b, c, d};
-        board.push_back(row);
-    }
-
-    // read move:
-    int m;
-    std::cin >> m;
-    move = static_cast<Move>(m);
-}
-
-bool cellEmpty(const Board& board, int i, int j) {
-    return board[i][j] == 0;
-}
-
-void swap(int& v1, int& v2) {
-   int c = v1;
-   v1 = v2;
-   v2 = c;
-}
-
-void move(Board& board, const Move& m, int i, int j, MSet& mergedTiles);
-
-void moveTo(Board& board, int i, int j, int ni, int nj, const Move& m, MSet& mergedTiles) {
-    if (ni >= 0 && ni < DIM && nj >= 0 && nj < DIM) {
-       if (cellEmpty(board, ni, nj)) {
-            swap(board[i][j], board[ni][nj]);
-            move(board, m, ni, nj, mergedTiles); // could move again
-       } else { // collision
-            if (board[i][j] == board[ni][nj] && mergedTiles.find(std::make_pair(ni,nj)) == mergedTiles.end()) {
-                // same value that should be merged because this tile hasn't merged yet
-                board[ni][nj] = 2 * board[i][j];
-                board[i][j] = 0;
-                mergedTiles.insert(std::make_pair(ni,nj));
-            } 
-            return;
-       }
-    }
-}
+#include "Simulator.h"
+#include "Expectimax.h"
+#include "Batch.h"
 
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 
-void move(Board& board, const Move& m, int i, int j, MSet& mergedTiles) {
-    if (board[i][j] == 0) {
-        // empty tiles cant move
-        return;
+/// plays 'nbrGames' games with the expectimax AI and prints one line per game and a summary
+void playGames(int nbrGames, const ExpectimaxParams& params, unsigned int seed) {
+    ExpectimaxAI ai(params);
+    int64_t totalMoves = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int game = 0; game < nbrGames; ++game) {
+        GameResult result = playGame(ai, seed + game);
+        totalMoves += result.nbrMoves;
+        std::cout << "game " << game << ": " << result.nbrMoves << " moves, max tile " << result.maxTile
+                  << ", score " << result.score << std::endl;
     }
-    int ni = i; // proposed coordinates from move
-    int nj = j; 
-    switch(m) {
-        case Move::LEFT:
-            nj -= 1;
-            break;
-        case Move::RIGHT:
-            nj += 1;
-            break;
-        case Move::UP:
-            ni -= 1;
-            break;
-        case Move::DOWN:
-            ni += 1;
-            break;
-    }
-    moveTo(board, i, j, ni, nj, m, mergedTiles);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Expectimax | " << nbrGames << " games, " << totalMoves / seconds << " moves/s, "
+              << ai.nbrNodes() / seconds << " nodes/s" << std::endl;
 }
 
-void solve(Board& board, const Move& m) {
-    int empty = 0; // value of 0: empty field in board
-    MSet mergedTiles; // indices of tiles that have been merged due to the move and shouldnt merge again
-    if (m == Move::LEFT || m == Move::UP) {
-        // start with entries at top & LHS
-        for (int i = 0; i < DIM; ++i) {
-            for (int j = 0; j < DIM; ++j) {
-                move(board, m, i, j, mergedTiles);
-            }
-        }
-    } else if (m == Move::RIGHT) {
-        // start with entries at RHS
-        for (int i = 0; i < DIM; ++i) {
-            for (int j = DIM-1; j >= 0; --j) {
-                move(board, m, i, j, mergedTiles);
-            }
-        }
-    } else if (m == Move::DOWN) {
-        // start with entries at bottom
-        for (int i = DIM-1; i >= 0; --i) {
-            for (int j = 0; j < DIM; ++j) {
-                move(board, m, i, j, mergedTiles);
-            }
+int main(int argc, char** argv) {
+    // usage: SimulateMove [dim] < board and move
+    //        SimulateMove play [nbrGames] [maxDepth] [timeBudget in ms] [seed]
+    //        SimulateMove batch [nbrThreads] [dim] < records of board and move
+    if (argc > 1 && std::strcmp(argv[1], "batch") == 0) {
+        int dim = argc > 3 ? std::atoi(argv[3]) : 4;
+        BatchStats stats = runBatch(stdin, stdout, argc > 2 ? std::atoi(argv[2]) : 0, dim);
+        if (stats.nbrRecords < 0) {
+            std::cerr << "unsupported board dimension " << dim << std::endl;
+            return 1;
         }
+        std::cerr << "Batch | " << stats.nbrRecords << " records, " << stats.nbrValueMoves << " moved on the values" << std::endl;
+        return 0;
     }
-}
-
-void printOutput(const Board& board) {
-    for (int i = 0; i < DIM; ++i) {
-        for (int j = 0; j < DIM; ++j) {
-            std::cout << board[i][j];
-            if (j != DIM-1) {
-                std::cout << " ";
-            } else {
-                std::cout << std::endl;
-            }
-        }
+    if (argc > 1 && std::strcmp(argv[1], "play") == 0) {
+        ExpectimaxParams params;
+        int nbrGames = argc > 2 ? std::atoi(argv[2]) : 1;
+        params.maxDepth = argc > 3 ? std::atoi(argv[3]) : params.maxDepth;
+        params.timeBudget = argc > 4 ? std::atof(argv[4]) / 1e3 : params.timeBudget;
+        unsigned int seed = argc > 5 ? std::atoi(argv[5]) : 1;
+        playGames(nbrGames, params, seed);
+        return 0;
+    }
+    int dim = argc > 1 ? std::atoi(argv[1]) : 4; // 4 by 4 game board
+    if (!simulate(std::cin, std::cout, dim)) {
+        std::cerr << "unsupported board dimension " << dim << " or incomplete input" << std::endl;
+        return 1;
     }
-}
-int main(int argc, char** argv) {
-    Board board;
-    Move move;
-    parseInput(board, move);
-
-    // determine state after performing move on board
-    solve(board, move); 
-    printOutput(board);
 }
@@ -0,0 +1,110 @@
+#include "BatchScorer.h"
+#include "Scorer.h"
+
+#include <array>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+void scoreBatchScalar(const uint8_t* const dice[5], int nbrRolls, uint8_t* const scores[11]) {
+    std::array<uint8_t, 5> roll;
+    for (int r = 0; r < nbrRolls; ++r) {
+        for (int i = 0; i < 5; ++i) {
+            roll[i] = dice[i][r];
+        }
+        for (int combiId = 1; combiId <= 11; ++combiId) {
+            scores[combiId - 1][r] = scoreRoll(roll, static_cast<Combination>(combiId));
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+namespace {
+
+/// scores the rolls [0, nbrRolls - nbrRolls % 32), 32 rolls per iteration (one byte lane per roll)
+__attribute__((target("avx2")))
+int scoreBatchAvx2(const uint8_t* const dice[5], int nbrRolls, uint8_t* const scores[11]) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    int r = 0;
+    for (; r + 32 <= nbrRolls; r += 32) {
+        __m256i d[5];
+        __m256i sum = zero;
+        for (int i = 0; i < 5; ++i) {
+            d[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dice[i] + r));
+            sum = _mm256_add_epi8(sum, d[i]);
+        }
+        // histogram: counts[v] = number of dice with value v (compare gives -1 per match)
+        __m256i counts[7];
+        for (int v = 1; v <= 6; ++v) {
+            __m256i value = _mm256_set1_epi8(v);
+            __m256i c = zero;
+            for (int i = 0; i < 5; ++i) {
+                c = _mm256_sub_epi8(c, _mm256_cmpeq_epi8(d[i], value));
+            }
+            counts[v] = c;
+        }
+        // ONES .. SIXES: v * counts[v] by additions (no 8 bit multiplication in AVX2)
+        __m256i c2 = _mm256_add_epi8(counts[2], counts[2]);
+        __m256i c3 = _mm256_add_epi8(_mm256_add_epi8(counts[3], counts[3]), counts[3]);
+        __m256i c4 = _mm256_add_epi8(counts[4], counts[4]);
+        c4 = _mm256_add_epi8(c4, c4);
+        __m256i c5 = _mm256_add_epi8(counts[5], counts[5]);
+        c5 = _mm256_add_epi8(_mm256_add_epi8(c5, c5), counts[5]);
+        __m256i c6 = _mm256_add_epi8(_mm256_add_epi8(counts[6], counts[6]), counts[6]);
+        c6 = _mm256_add_epi8(c6, c6);
+        const __m256i repetitions[6] = {counts[1], c2, c3, c4, c5, c6};
+        for (int v = 0; v < 6; ++v) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores[v] + r), repetitions[v]);
+        }
+        // N of a kind masks
+        __m256i has[6] = {zero, zero, zero, zero, zero, zero}; // has[n]: some value is repeated exactly n times
+        for (int n = 2; n <= 5; ++n) {
+            __m256i nn = _mm256_set1_epi8(n);
+            for (int v = 1; v <= 6; ++v) {
+                has[n] = _mm256_or_si256(has[n], _mm256_cmpeq_epi8(counts[v], nn));
+            }
+        }
+        // SEQUENCE: 2, 3, 4, 5 exactly once and 1 or 6 once
+        __m256i inner = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(counts[2], one), _mm256_cmpeq_epi8(counts[3], one)),
+                                         _mm256_and_si256(_mm256_cmpeq_epi8(counts[4], one), _mm256_cmpeq_epi8(counts[5], one)));
+        __m256i outer = _mm256_or_si256(_mm256_cmpeq_epi8(counts[1], one), _mm256_cmpeq_epi8(counts[6], one));
+        __m256i sequence = _mm256_and_si256(sum, _mm256_and_si256(inner, outer));
+        __m256i fullHouse = _mm256_and_si256(sum, _mm256_and_si256(has[3], has[2]));
+        __m256i fourOfAKind = _mm256_and_si256(sum, has[4]);
+        __m256i fiveOfAKind = _mm256_and_si256(_mm256_set1_epi8(FIVE_OF_A_KIND_SCORE), has[5]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores[6] + r), sequence);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores[7] + r), fullHouse);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores[8] + r), fourOfAKind);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores[9] + r), fiveOfAKind);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores[10] + r), sum);
+    }
+    return r;
+}
+
+} // namespace
+#endif
+
+bool batchScorerUsesAvx2() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+#else
+    return false;
+#endif
+}
+
+void scoreBatch(const uint8_t* const dice[5], int nbrRolls, uint8_t* const scores[11]) {
+    int done = 0;
+#if defined(__x86_64__) || defined(__i386__)
+    if (batchScorerUsesAvx2()) done = scoreBatchAvx2(dice, nbrRolls, scores);
+#endif
+    if (done < nbrRolls) {
+        // remaining rolls (less than one vector)
+        const uint8_t* restDice[5];
+        uint8_t* restScores[11];
+        for (int i = 0; i < 5; ++i) restDice[i] = dice[i] + done;
+        for (int c = 0; c < 11; ++c) restScores[c] = scores[c] + done;
+        scoreBatchScalar(restDice, nbrRolls - done, restScores);
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+/* Scores batches of independent five-dice rolls for all 11 combinations at once.
+ * Rolls are in structure-of-arrays layout: dice[i][r] is the value (1..6) of dice i of roll r,
+ * scores[c][r] receives the score of roll r for combination c+1 (all scores fit into a byte).
+ * The results match scoreRoll exactly.
+ */
+
+void scoreBatch(const uint8_t* const dice[5], int nbrRolls, uint8_t* const scores[11]);
+    /// uses AVX2 if the cpu supports it, the scalar version otherwise
+
+void scoreBatchScalar(const uint8_t* const dice[5], int nbrRolls, uint8_t* const scores[11]);
+
+bool batchScorerUsesAvx2();
@@ -0,0 +1,136 @@
+#include "BeamSearch.h"
+#include "GameState.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+namespace {
+
+constexpr int NBR_MASKS = 1 << 11;      // subsets of used combinations
+
+struct BeamNode {
+    uint16_t cursor;
+    uint16_t usedMask;
+    int score;
+    int parent;                 // index of the node in the previous round
+    uint8_t combiId;            // combination registered in the round leading to this node
+    int bound;
+    int key() const { return cursor * NBR_MASKS + usedMask; }
+};
+
+/* Best child of each (cursor, used combinations) of one round.
+ * Entries pack score, parent and combination so that concurrent updates are a single atomic max;
+ * ties go to the higher parent index, so the result does not depend on the thread schedule.
+ */
+class ChildTable {
+public:
+    ChildTable(int sequenceLength) : m_entries((sequenceLength + 1) * NBR_MASKS) {
+        for (auto& e : m_entries) e.store(0, std::memory_order_relaxed);
+    }
+    static uint64_t pack(int score, int parent, int combiId) {
+        return (static_cast<uint64_t>(score + 1) << 32) | (static_cast<uint64_t>(parent) << 4) | combiId;
+    }
+    /// returns true if 'key' had no child before
+    bool offer(int key, uint64_t packed) {
+        std::atomic<uint64_t>& e = m_entries[key];
+        uint64_t old = e.load(std::memory_order_relaxed);
+        while (old < packed && !e.compare_exchange_weak(old, packed, std::memory_order_relaxed)) {}
+        return old == 0;
+    }
+    BeamNode take(int key) {
+        uint64_t packed = m_entries[key].exchange(0, std::memory_order_relaxed);
+        return BeamNode{static_cast<uint16_t>(key / NBR_MASKS), static_cast<uint16_t>(key % NBR_MASKS),
+                        static_cast<int>(packed >> 32) - 1, static_cast<int>((packed >> 4) & 0xFFFFFFF),
+                        static_cast<uint8_t>(packed & 0xF), 0};
+    }
+private:
+    std::vector<std::atomic<uint64_t>> m_entries;
+};
+
+/// offers all children of beam[first, last) to 'children', returns the keys of the new entries
+void expand(const std::vector<BeamNode>& beam, int first, int last, const ScoreIndex& index,
+            ChildTable& children, std::vector<int>& newKeys) {
+    for (int i = first; i < last; ++i) {
+        const BeamNode& node = beam[i];
+        for (int combiId = 1; combiId <= 11; ++combiId) {
+            int bit = 1 << (combiId - 1);
+            if (node.usedMask & bit) continue;
+            for (int length = 5; length <= MAX_ROUND_LENGTH && node.cursor + length <= index.sequenceLength(); ++length) {
+                int score = node.score + index.option(node.cursor, length, combiId).score;
+                int key = (node.cursor + length) * NBR_MASKS + (node.usedMask | bit);
+                if (children.offer(key, ChildTable::pack(score, i, combiId))) {
+                    newKeys.push_back(key);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+GamePlan solveBeam(const std::vector<int>& diceSequence, const BeamParams& params) {
+    return solveBeam(ScoreIndex(diceSequence), params);
+}
+
+GamePlan solveBeam(const ScoreIndex& index, const BeamParams& params) {
+    ChildTable children(index.sequenceLength());
+    int nbrThreads = params.nbrThreads > 0 ? params.nbrThreads : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::vector<BeamNode>> rounds(12);
+    rounds[0].push_back(BeamNode{0, 0, 0, -1, 0, index.bound(0, 0)});
+    for (int round = 0; round < 11; ++round) {
+        const std::vector<BeamNode>& beam = rounds[round];
+        // small beams are not worth the thread start
+        int nbrChunks = std::min<int>(nbrThreads, (beam.size() + 255) / 256);
+        std::vector<std::vector<int>> newKeys(nbrChunks);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < nbrChunks; ++t) {
+            int first = beam.size() * t / nbrChunks;
+            int last = beam.size() * (t + 1) / nbrChunks;
+            if (t == nbrChunks - 1) {
+                expand(beam, first, last, index, children, newKeys[t]);
+            } else {
+                threads.emplace_back(expand, std::cref(beam), first, last, std::cref(index), std::ref(children), std::ref(newKeys[t]));
+            }
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<BeamNode>& next = rounds[round + 1];
+        for (const auto& keys : newKeys) {
+            for (int key : keys) {
+                BeamNode node = children.take(key);
+                node.bound = node.score + index.bound(node.cursor, node.usedMask);
+                next.push_back(node);
+            }
+        }
+        if (params.beamWidth > 0 && static_cast<int>(next.size()) > params.beamWidth) {
+            std::nth_element(next.begin(), next.begin() + params.beamWidth, next.end(), [](const BeamNode& a, const BeamNode& b) {
+                return a.bound != b.bound ? a.bound > b.bound : a.key() < b.key();
+            });
+            next.resize(params.beamWidth);
+        }
+        // deterministic order, independent of the number of threads
+        std::sort(next.begin(), next.end(), [](const BeamNode& a, const BeamNode& b) { return a.key() < b.key(); });
+    }
+
+    const std::vector<BeamNode>& last = rounds[11];
+    assert(!last.empty() && "dice sequence too short");
+    int best = std::max_element(last.begin(), last.end(), [](const BeamNode& a, const BeamNode& b) {
+        return a.score < b.score;
+    }) - last.begin();
+
+    GamePlan plan;
+    plan.score = last[best].score;
+    for (int round = 11, i = best; round > 0; --round) {
+        const BeamNode& node = rounds[round][i];
+        const BeamNode& parent = rounds[round - 1][node.parent];
+        const RoundOption& o = index.option(parent.cursor, node.cursor - parent.cursor, node.combiId);
+        plan.rounds[round - 1] = {parent.cursor, o.firstReRoll, o.secondReRoll, static_cast<Combination>(node.combiId), o.score};
+        i = node.parent;
+    }
+    return plan;
+}
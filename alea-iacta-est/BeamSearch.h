@@ -0,0 +1,25 @@
+#pragma once
+
+#include "GameState.h"
+#include "ScoreIndex.h"
+
+#include <vector>
+
+/* Beam search over the known dice sequence.
+ * A round is fully described by its start in the dice sequence, the two re-roll masks and the
+ * registered combination. For each start, length (5..15 dice) and combination only the best
+ * re-roll masks matter (see ScoreIndex), so the search expands (cursor, used combinations)
+ * states round by round.
+ * States with the same cursor and used combinations are merged (only the best score survives).
+ * The beam keeps the 'beamWidth' states with the highest bound:
+ *   score + sum over the unused combinations of their best score in the remaining dice sequence.
+ * beamWidth 0 keeps all states, i.e. exact dynamic programming.
+ */
+
+struct BeamParams {
+    int beamWidth = 1000;   // number of states kept per round, 0: unbounded (exact)
+    int nbrThreads = 0;     // threads expanding a round, 0: one per core
+};
+
+GamePlan solveBeam(const ScoreIndex& index, const BeamParams& params);
+GamePlan solveBeam(const std::vector<int>& diceSequence, const BeamParams& params);
@@ -0,0 +1,337 @@
+#include "Genetic.h"
+#include "RNG.h"
+#include "Islands.h"
+#include "GameState.h"
+#include "Scorer.h"
+#include "BeamSearch.h"
+#include "Greedy.h"
+#include "BatchScorer.h"
+#include "Checkpoint.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <thread>
+
+/// Throughput benchmarks for the alea-iacta-est solvers
+
+/// measures the number of generations per second of the genetic algorithm, returns the final population
+std::vector<Chromosome> benchmarkGenetic(const std::vector<int>& diceSequence, int nbrGenerations, int populationSize, bool exactAssignment = true) {
+    GParams params;
+    params.populationSize = populationSize;
+    params.exactAssignment = exactAssignment;
+    GState state{initializePopulation(diceSequence, params.populationSize, params.seedRatio, assignmentKernel(params)), 0};
+    auto t = std::chrono::steady_clock::now();
+    while (state.generationNbr < nbrGenerations) {
+        evolve(state, diceSequence, params);
+    }
+    auto tt = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(tt - t).count();
+    std::cout << "Genetic | population " << populationSize << (exactAssignment ? "" : " (greedy assignment)") << ", " << nbrGenerations << " generations in " << seconds << " s: "
+        << nbrGenerations / seconds << " generations/s, max fitness: " << state.population[state.fittest].fitness << std::endl;
+    return state.population;
+}
+
+/// runs solveGenetic for 'nbrGenerations' with a checkpoint file, then resumes it from the file for as many generations
+void benchmarkCheckpoint(const std::vector<int>& diceSequence, int nbrGenerations) {
+    const std::string fileName = "benchmark.checkpoint";
+    std::remove(fileName.c_str());
+    GParams params;
+    params.maxGenerations = nbrGenerations;
+    params.stagnationWindow = 0;
+    params.telemetryInterval = std::max(1, nbrGenerations / 2);
+    params.checkpointFile = fileName;
+    params.checkpointInterval = std::max(1, nbrGenerations / 2);
+    auto t = std::chrono::steady_clock::now();
+    Chromosome first = solveGenetic(diceSequence, params);
+    std::optional<GState> saved = loadCheckpoint(fileName, diceSequence, params.populationSize);
+    params.maxGenerations = 2 * nbrGenerations;
+    auto tt = std::chrono::steady_clock::now();
+    Chromosome resumed = solveGenetic(diceSequence, params);
+    auto ttt = std::chrono::steady_clock::now();
+    std::optional<GState> final = loadCheckpoint(fileName, diceSequence, params.populationSize);
+    bool rejectsOtherSize = !loadCheckpoint(fileName, diceSequence, params.populationSize + 1);
+    std::remove(fileName.c_str());
+    bool ok = saved && saved->generationNbr == nbrGenerations && saved->population[saved->fittest].fitness == first.fitness
+        && final && final->generationNbr == 2 * nbrGenerations && resumed.fitness >= first.fitness && rejectsOtherSize;
+    std::cout << "Checkpoint | " << nbrGenerations << " generations in " << std::chrono::duration<double>(tt - t).count()
+        << " s, max fitness " << first.fitness << ", resumed for " << nbrGenerations << " generations in "
+        << std::chrono::duration<double>(ttt - tt).count() << " s, max fitness " << resumed.fitness
+        << (ok ? ", checkpoints consistent" : ", CHECKPOINTS INCONSISTENT") << std::endl;
+}
+
+/// compares the greedy and the optimal assignment kernel on the score matrices of a population,
+/// the optimal one from scratch and from the assignment of the chromosome with one changed row (as after a mutation)
+void benchmarkAssignment(const std::vector<Chromosome>& population, int nbrRepetitions) {
+    struct Kernel {
+        const char* name;
+        AssignFn assign;
+        uint16_t changedRows;
+    };
+    const Kernel kernels[] = {{"greedy", assignGreedily, 0x7ff}, {"optimal", assignOptimally, 0x7ff},
+                              {"optimal, 1 changed row", assignOptimally, 0x001}};
+    for (const Kernel& kernel : kernels) {
+        long totalScore = 0;
+        auto t = std::chrono::steady_clock::now();
+        for (int r = 0; r < nbrRepetitions; ++r) {
+            for (const Chromosome& c : population) {
+                AssignmentState state = c.assignment;
+                totalScore += kernel.assign(c.groupScores, kernel.changedRows, state);
+            }
+        }
+        auto tt = std::chrono::steady_clock::now();
+        long nbrAssignments = static_cast<long>(nbrRepetitions) * population.size();
+        double seconds = std::chrono::duration<double>(tt - t).count();
+        std::cout << "Assignment | " << kernel.name << ": " << seconds / nbrAssignments * 1e9 << " ns/assignment, mean score: "
+            << static_cast<double>(totalScore) / nbrAssignments << std::endl;
+    }
+}
+
+/// measures the effect of the fitness cache and of rejecting duplicates
+void benchmarkFitnessCache(const std::vector<int>& diceSequence, int nbrGenerations) {
+    for (int config = 0; config < 3; ++config) {
+        FitnessCache cache;
+        GParams params;
+        params.fitnessCache = config >= 1 ? &cache : nullptr;
+        params.rejectDuplicates = config >= 2;
+        seedGenetic(1);
+        GState state(initializePopulation(diceSequence, params.populationSize));
+        auto t = std::chrono::steady_clock::now();
+        while (state.generationNbr < nbrGenerations) {
+            evolve(state, diceSequence, params);
+        }
+        auto tt = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(tt - t).count();
+        Telemetry telemetry = collectTelemetry(state);
+        std::cout << "Cache | " << (params.fitnessCache ? "cache" : "no cache") << (params.rejectDuplicates ? ", reject duplicates" : "")
+            << ": " << nbrGenerations / seconds << " generations/s, hit rate: " << cache.hitRate()
+            << ", max fitness: " << telemetry.maxFitness << ", diversity: " << telemetry.diversity << std::endl;
+    }
+}
+
+/// number of generations until the max fitness reaches 'target' (at most 'maxGenerations')
+int generationsToTarget(const std::vector<int>& diceSequence, double seedRatio, int target, int maxGenerations, int& initialFitness) {
+    GParams params;
+    params.seedRatio = seedRatio;
+    params.rejectDuplicates = true;
+    seedGenetic(1);
+    GState state(initializePopulation(diceSequence, params.populationSize, params.seedRatio));
+    initialFitness = state.population[state.fittest].fitness;
+    while (state.population[state.fittest].fitness < target && state.generationNbr < maxGenerations) {
+        evolve(state, diceSequence, params);
+    }
+    return state.generationNbr;
+}
+
+/// compares how fast populations with different ratios of seeded chromosomes reach the score of an unseeded run
+void benchmarkSeeding(const std::vector<int>& diceSequence, int nbrGenerations) {
+    // target: max fitness of an unseeded population after 'nbrGenerations'
+    GParams params;
+    params.seedRatio = 0.0;
+    params.rejectDuplicates = true;
+    seedGenetic(1);
+    GState state(initializePopulation(diceSequence, params.populationSize, params.seedRatio));
+    while (state.generationNbr < nbrGenerations) {
+        evolve(state, diceSequence, params);
+    }
+    int target = state.population[state.fittest].fitness;
+    int initialFitness;
+    for (double seedRatio : {0.0, 0.1, 0.5}) {
+        auto t = std::chrono::steady_clock::now();
+        int generations = generationsToTarget(diceSequence, seedRatio, target, nbrGenerations, initialFitness);
+        auto tt = std::chrono::steady_clock::now();
+        std::cout << "Seeding | seed ratio " << seedRatio << ": initial max fitness: " << initialFitness
+            << ", target " << target << " reached after " << generations << " generations ("
+            << std::chrono::duration<double>(tt - t).count() << " s incl. initialization)" << std::endl;
+    }
+}
+
+/// compares the fittest chromosome found by a single population and by islands in the same wall clock time
+void benchmarkIslands(const std::vector<int>& diceSequence, double timeLimit) {
+    int nbrCores = std::max(2u, std::thread::hardware_concurrency());
+    for (int nbrIslands : {1, nbrCores}) {
+        IslandParams islandParams;
+        islandParams.nbrIslands = nbrIslands;
+        GParams params;
+        params.timeLimit = timeLimit;
+        params.stagnationWindow = 0;
+        Chromosome fittest = solveIslands(diceSequence, params, islandParams);
+        std::cout << "Islands | " << nbrIslands << " island(s) in " << timeLimit << " s: max fitness: " << fittest.fitness << std::endl;
+    }
+}
+
+/// measures simulated moves per second of random playouts that probe every free combination by make/unmake
+void benchmarkSimulator(const std::vector<int>& diceSequence, int nbrGames) {
+    Simulator sim(diceSequence);
+    const GameState start = sim.state();
+    unsigned rand = 1;
+    auto nextRand = [&rand]() { rand = rand * 1103515245u + 12345u; return rand >> 16; };
+    long nbrMoves = 0;
+    long totalScore = 0;
+    auto t = std::chrono::steady_clock::now();
+    for (int g = 0; g < nbrGames; ++g) {
+        while (!sim.state().hasEnded()) {
+            sim.make({MoveType::ROLL, 0});
+            sim.make({MoveType::REROLL, static_cast<uint8_t>(nextRand() & 31)});
+            sim.make({MoveType::REROLL, static_cast<uint8_t>(nextRand() & 31)});
+            nbrMoves += 3;
+            int free[11], nbrFree = 0;
+            for (int c = 1; c <= 11; ++c) {
+                if (!sim.state().isUsed(static_cast<Combination>(c))) {
+                    GameState previous = sim.make({MoveType::REGISTER, static_cast<uint8_t>(c)});
+                    sim.unmake(previous);
+                    free[nbrFree++] = c;
+                    nbrMoves += 2;
+                }
+            }
+            sim.make({MoveType::REGISTER, static_cast<uint8_t>(free[nextRand() % nbrFree])});
+            nbrMoves += 1;
+        }
+        totalScore += sim.state().totalScore;
+        sim.unmake(start);
+    }
+    auto tt = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(tt - t).count();
+    std::cout << "Simulator | " << nbrGames << " games in " << seconds << " s: " << nbrMoves / seconds << " moves/s, mean score: "
+        << static_cast<double>(totalScore) / nbrGames << std::endl;
+
+    // scorer on all 6^5 rolls: vector interface (as used by Roll) vs. fixed array
+    std::vector<int> roll(5);
+    std::array<uint8_t, 5> dice;
+    long vectorSum = 0, arraySum = 0;
+    const int nbrRolls = 6 * 6 * 6 * 6 * 6;
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < nbrRolls; ++r) {
+        for (int i = 0, x = r; i < 5; ++i, x /= 6) roll[i] = x % 6 + 1;
+        for (int c = 1; c <= 11; ++c) vectorSum += scoreRoll(roll, static_cast<Combination>(c));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for (int r = 0; r < nbrRolls; ++r) {
+        for (int i = 0, x = r; i < 5; ++i, x /= 6) dice[i] = x % 6 + 1;
+        for (int c = 1; c <= 11; ++c) arraySum += scoreRoll(dice, static_cast<Combination>(c));
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    std::cout << "Scorer | vector: " << std::chrono::duration<double>(t2 - t1).count() / (nbrRolls * 11) * 1e9
+        << " ns/score, array: " << std::chrono::duration<double>(t3 - t2).count() / (nbrRolls * 11) * 1e9
+        << " ns/score" << (vectorSum == arraySum ? "" : " (MISMATCH)") << std::endl;
+}
+
+/// score and latency of the greedy solvers and of the beam search for increasing beam widths (0: exact)
+void benchmarkBeam(const std::vector<int>& diceSequence, int nbrThreads) {
+    auto t0 = std::chrono::steady_clock::now();
+    ScoreIndex index(diceSequence);
+    auto t1 = std::chrono::steady_clock::now();
+    GamePlan veryGreedy = solveVeryGreedily(index);
+    GamePlan greedy = solveGreedily(index);
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << "Index | " << std::chrono::duration<double>(t1 - t0).count() * 1e3 << " ms, greedy solvers: "
+        << std::chrono::duration<double>(t2 - t1).count() * 1e6 << " us, very greedy: " << veryGreedy.score
+        << ", greedy: " << greedy.score
+        << (playPlan(diceSequence, veryGreedy) == veryGreedy.score && playPlan(diceSequence, greedy) == greedy.score ? "" : " (REPLAY MISMATCH)")
+        << std::endl;
+    for (int beamWidth : {1, 10, 100, 1000, 10000, 0}) {
+        BeamParams params;
+        params.beamWidth = beamWidth;
+        params.nbrThreads = nbrThreads;
+        auto t = std::chrono::steady_clock::now();
+        GamePlan plan = solveBeam(index, params);
+        auto tt = std::chrono::steady_clock::now();
+        int replayed = playPlan(diceSequence, plan);
+        std::cout << "Beam | width " << beamWidth << ": score " << plan.score << " in "
+            << std::chrono::duration<double>(tt - t).count() * 1e3 << " ms"
+            << (replayed == plan.score ? "" : " (REPLAY MISMATCH)") << std::endl;
+    }
+}
+
+/// checks the batch scorer against scoreRoll on all 6^5 rolls and measures rolls/s of the scalar and the batch scorer
+void benchmarkBatchScorer(int nbrRepetitions) {
+    const int nbrRolls = 6 * 6 * 6 * 6 * 6;
+    std::vector<uint8_t> dice(5 * nbrRolls), scores(11 * nbrRolls);
+    const uint8_t* diceRows[5];
+    uint8_t* scoreRows[11];
+    for (int i = 0; i < 5; ++i) diceRows[i] = &dice[i * nbrRolls];
+    for (int c = 0; c < 11; ++c) scoreRows[c] = &scores[c * nbrRolls];
+    for (int r = 0; r < nbrRolls; ++r) {
+        for (int i = 0, x = r; i < 5; ++i, x /= 6) dice[i * nbrRolls + r] = x % 6 + 1;
+    }
+    using BatchFn = void (*)(const uint8_t* const*, int, uint8_t* const*);
+    const std::pair<const char*, BatchFn> kernels[] = {{"scalar", scoreBatchScalar}, {batchScorerUsesAvx2() ? "avx2" : "dispatch (no avx2)", scoreBatch}};
+    for (const auto& kernel : kernels) {
+        int mismatches = 0;
+        kernel.second(diceRows, nbrRolls, scoreRows);
+        for (int r = 0; r < nbrRolls; ++r) {
+            std::array<uint8_t, 5> roll;
+            for (int i = 0; i < 5; ++i) roll[i] = dice[i * nbrRolls + r];
+            for (int c = 0; c < 11; ++c) {
+                mismatches += scoreRows[c][r] != scoreRoll(roll, static_cast<Combination>(c + 1));
+            }
+        }
+        auto t = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < nbrRepetitions; ++rep) {
+            kernel.second(diceRows, nbrRolls, scoreRows);
+        }
+        auto tt = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(tt - t).count();
+        std::cout << "Batch scorer | " << kernel.first << ": " << static_cast<double>(nbrRolls) * nbrRepetitions / seconds
+            << " rolls/s (all 11 combinations), mismatches on all 6^5 rolls: " << mismatches << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    // usage: benchmark [genetic [nbrGenerations] | cache [nbrGenerations] | seeding [nbrGenerations] | islands [seconds] | simulator [nbrGames] | beam [nbrThreads] | batch [nbrRepetitions] | checkpoint [nbrGenerations]]
+    std::string mode = argc > 1 ? argv[1] : "genetic";
+    seedGenetic(1); // reproducible runs
+    const Scenario scenarios[] = {{69069, 5, 0}, {69069, 5, 2}, {1664525, 1013904223, 177}, {1103515245, 12345, 67890}}; // alea.in
+    if (mode == "genetic") {
+        int nbrGenerations = argc > 2 ? std::atoi(argv[2]) : 20000;
+        RNG rng(scenarios[0]);
+        auto diceSequence = determineDiceSequence(rng);
+        auto population = benchmarkGenetic(diceSequence, nbrGenerations, GParams().populationSize);
+        benchmarkAssignment(population, 2000);
+        benchmarkGenetic(diceSequence, nbrGenerations, GParams().populationSize, false);
+        for (int populationSize : {1000, 10000, 100000}) {
+            benchmarkGenetic(diceSequence, nbrGenerations, populationSize);
+        }
+    } else if (mode == "cache") {
+        int nbrGenerations = argc > 2 ? std::atoi(argv[2]) : 200000;
+        for (const Scenario& scenario : scenarios) {
+            RNG rng(scenario);
+            benchmarkFitnessCache(determineDiceSequence(rng), nbrGenerations);
+        }
+    } else if (mode == "seeding") {
+        int nbrGenerations = argc > 2 ? std::atoi(argv[2]) : 200000;
+        for (const Scenario& scenario : scenarios) {
+            RNG rng(scenario);
+            benchmarkSeeding(determineDiceSequence(rng), nbrGenerations);
+        }
+    } else if (mode == "islands") {
+        double timeLimit = argc > 2 ? std::atof(argv[2]) : 5.0;
+        for (const Scenario& scenario : scenarios) {
+            RNG rng(scenario);
+            benchmarkIslands(determineDiceSequence(rng), timeLimit);
+        }
+    } else if (mode == "simulator") {
+        int nbrGames = argc > 2 ? std::atoi(argv[2]) : 1000000;
+        RNG rng(scenarios[0]);
+        benchmarkSimulator(determineDiceSequence(rng), nbrGames);
+    } else if (mode == "beam") {
+        int nbrThreads = argc > 2 ? std::atoi(argv[2]) : 0;
+        for (const Scenario& scenario : scenarios) {
+            RNG rng(scenario);
+            benchmarkBeam(determineDiceSequence(rng), nbrThreads);
+        }
+    } else if (mode == "batch") {
+        benchmarkBatchScorer(argc > 2 ? std::atoi(argv[2]) : 200);
+    } else if (mode == "checkpoint") {
+        int nbrGenerations = argc > 2 ? std::atoi(argv[2]) : 200000;
+        RNG rng(scenarios[0]);
+        benchmarkCheckpoint(determineDiceSequence(rng), nbrGenerations);
+    } else {
+        std::cerr << "Unknown benchmark: " << mode << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "Checkpoint.h"
+#include "Genetic.h"
+
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char magic[8] = {'A', 'L', 'E', 'A', 'G', 'A', '0', '1'};
+
+struct Header {
+    char magic[8];
+    uint32_t chromosomeSize; // sizeof(Chromosome) of the writing build
+    int32_t generationNbr;
+    int32_t lastImprovement;
+    uint32_t populationSize;
+    uint32_t diceSequenceSize;
+    uint32_t telemetrySize;
+};
+
+template<typename T>
+void writeRaw(std::ofstream& os, const T* data, size_t n) {
+    os.write(reinterpret_cast<const char*>(data), n * sizeof(T));
+}
+
+template<typename T>
+bool readRaw(std::ifstream& is, T* data, size_t n) {
+    is.read(reinterpret_cast<char*>(data), n * sizeof(T));
+    return static_cast<bool>(is);
+}
+}
+
+bool saveCheckpoint(const std::string& fileName, const GState& state, const std::vector<int>& diceSequence) {
+    // write to a temporary file first so that an interrupted write does not destroy the last checkpoint
+    std::string tmpFileName = fileName + ".tmp";
+    std::ofstream os(tmpFileName, std::ios::binary | std::ios::trunc);
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.chromosomeSize = sizeof(Chromosome);
+    header.generationNbr = state.generationNbr;
+    header.lastImprovement = state.lastImprovement;
+    header.populationSize = state.population.size();
+    header.diceSequenceSize = diceSequence.size();
+    header.telemetrySize = state.telemetry.size();
+    writeRaw(os, &header, 1);
+    std::vector<uint8_t> dice(diceSequence.begin(), diceSequence.end());
+    writeRaw(os, dice.data(), dice.size());
+    writeRaw(os, state.population.data(), state.population.size());
+    writeRaw(os, state.telemetry.data(), state.telemetry.size());
+    os.close();
+    if (!os || std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+        std::cerr << "Could not write checkpoint: " << fileName << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::optional<GState> loadCheckpoint(const std::string& fileName, const std::vector<int>& diceSequence, int populationSize) {
+    std::ifstream is(fileName, std::ios::binary);
+    if (!is) {
+        return std::nullopt; // no checkpoint yet
+    }
+    Header header;
+    if (!readRaw(is, &header, 1) || std::memcmp(header.magic, magic, sizeof(magic)) != 0
+        || header.chromosomeSize != sizeof(Chromosome) || header.populationSize == 0) {
+        std::cerr << "Invalid checkpoint: " << fileName << std::endl;
+        return std::nullopt;
+    }
+    std::vector<uint8_t> dice(header.diceSequenceSize);
+    if (!readRaw(is, dice.data(), dice.size()) || !std::equal(dice.begin(), dice.end(), diceSequence.begin(), diceSequence.end())) {
+        std::cerr << "Checkpoint belongs to another dice sequence: " << fileName << std::endl;
+        return std::nullopt;
+    }
+    if (static_cast<int>(header.populationSize) != populationSize) {
+        std::cerr << "Checkpoint has a population of " << header.populationSize << " instead of "
+                  << populationSize << ": " << fileName << std::endl;
+        return std::nullopt;
+    }
+    std::vector<Chromosome> population(header.populationSize);
+    std::vector<Telemetry> telemetry(header.telemetrySize);
+    if (!readRaw(is, population.data(), population.size()) || !readRaw(is, telemetry.data(), telemetry.size())) {
+        std::cerr << "Truncated checkpoint: " << fileName << std::endl;
+        return std::nullopt;
+    }
+    GState state(std::move(population), header.generationNbr);
+    state.lastImprovement = header.lastImprovement;
+    state.telemetry = std::move(telemetry);
+    return state;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Genetic.h"
+
+#include <string>
+#include <vector>
+#include <optional>
+
+/* Binary checkpoints of the state of the genetic algorithm, so that long runs can be resumed.
+ * The file contains a header (format version, chromosome layout size, generation counters),
+ * the dice sequence the state belongs to, the raw chromosomes and the collected telemetry.
+ * Chromosomes are trivially copyable and therefore written as they are in memory:
+ * checkpoints can only be read by a build with the same Chromosome layout.
+ */
+
+/* Writes the state to 'fileName'. Returns false if the file could not be written */
+bool saveCheckpoint(const std::string& fileName, const GState& state, const std::vector<int>& diceSequence);
+
+/* Reads a state from 'fileName'. Returns nothing if the file does not exist, is invalid,
+ * belongs to another dice sequence or holds a population of another size than 'populationSize' */
+std::optional<GState> loadCheckpoint(const std::string& fileName, const std::vector<int>& diceSequence, int populationSize);
@@ -0,0 +1,214 @@
+#include "RNG.h"
+#include "GameState.h"
+#include "ScoreIndex.h"
+#include "Greedy.h"
+#include "BeamSearch.h"
+#include "Genetic.h"
+#include "ResultCache.h"
+#ifdef WITH_ILP
+#include "ILP.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+/// Runs all solvers on a seeded corpus of scenarios and reports score distribution, time and peak memory
+// usage: corpus [nbrRandomScenarios] [seed] [nbrGenerations] [resultCacheFile]
+// alea.in / alea.ans are added to the corpus if they are found in the working directory
+// built with 'make corpus ILP=1', the ILP solver (lp_solve) is run as well
+
+struct CorpusEntry {
+    Scenario scenario;
+    int expected; // known best score, -1: unknown
+};
+
+/* Degenerate LCG parameters (constant, slowly changing or collapsing sequences), the scenarios of
+ * alea.in and random scenarios drawn with 'seed' */
+std::vector<CorpusEntry> generateCorpus(int nbrRandomScenarios, unsigned int seed) {
+    std::vector<CorpusEntry> corpus = {
+        {{0, 0, 0}, -1},            // all dice 1
+        {{0, 12345, 0}, -1},        // constant after the first step
+        {{1, 0, 987654321}, -1},    // constant
+        {{1, 1, 0}, -1},            // counter, the high bits hardly change
+        {{2, 0, 1}, -1},            // collapses to 0 after 32 steps
+        {{65536, 1, 7}, -1},        // short period of the upper bits
+        {{69069, 0, 0}, -1},        // fixpoint 0
+    };
+    std::ifstream in("alea.in"), ans("alea.ans");
+    Scenario s;
+    while (in >> s.A >> s.C >> s.X && (s.A || s.C || s.X)) {
+        int expected = -1;
+        ans >> expected;
+        corpus.push_back({s, expected});
+    }
+    std::mt19937 engine(seed);
+    for (int i = 0; i < nbrRandomScenarios; ++i) {
+        std::uniform_int_distribution<int> param(0, 0x7fffffff);
+        std::uniform_int_distribution<int64_t> state(0, 0xffffffffLL);
+        corpus.push_back({{param(engine), param(engine), state(engine)}, -1});
+    }
+    return corpus;
+}
+
+/// peak resident set size of the process in KB
+long peakMemory() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+struct SolverRun {
+    std::string name;
+    std::vector<int> scores = {};   // per scenario
+    double seconds = 0.0;           // total over the corpus, including building the ScoreIndex
+    int replayFailures = 0;         // plans which do not replay to their score (or cannot be played at all)
+};
+
+/// score and whether the solution replays to it
+using Solver = std::function<int(const std::vector<int>& diceSequence, bool& replayed)>;
+
+SolverRun runSolver(const std::string& name, const Solver& solver, const std::vector<CorpusEntry>& corpus,
+                    const std::vector<std::vector<int>>& diceSequences) {
+    SolverRun run{name};
+    for (int i = 0; i < static_cast<int>(corpus.size()); ++i) {
+        auto t = std::chrono::steady_clock::now();
+        bool replayed = true;
+        run.scores.push_back(solver(diceSequences[i], replayed));
+        run.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+        run.replayFailures += !replayed;
+    }
+    return run;
+}
+
+void printRun(const SolverRun& run, const std::vector<int>& exact, long memory) {
+    std::vector<int> sorted = run.scores;
+    std::sort(sorted.begin(), sorted.end());
+    int n = sorted.size();
+    double mean = 0.0, gap = 0.0;
+    int aboveExact = 0;
+    for (int i = 0; i < n; ++i) {
+        mean += run.scores[i];
+        gap += exact[i] - run.scores[i];
+        aboveExact += run.scores[i] > exact[i];
+    }
+    std::cout << std::left << std::setw(14) << run.name << std::right
+        << " min " << std::setw(3) << sorted.front() << "  p10 " << std::setw(3) << sorted[n / 10]
+        << "  median " << std::setw(3) << sorted[n / 2] << "  max " << std::setw(3) << sorted.back()
+        << "  mean " << std::fixed << std::setprecision(1) << std::setw(6) << mean / n
+        << "  gap to exact " << std::setw(5) << gap / n
+        << "  " << std::setprecision(3) << std::setw(9) << run.seconds / n * 1e3 << " ms/scenario"
+        << "  peak memory " << memory << " KB" << std::defaultfloat;
+    if (run.replayFailures > 0) std::cout << "  REPLAY FAILURES: " << run.replayFailures;
+    if (aboveExact > 0) std::cout << "  ABOVE EXACT: " << aboveExact;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int nbrRandomScenarios = argc > 1 ? std::atoi(argv[1]) : 100;
+    unsigned int seed = argc > 2 ? std::atoi(argv[2]) : 1;
+    int nbrGenerations = argc > 3 ? std::atoi(argv[3]) : 20000;
+    std::string cacheFile = argc > 4 ? argv[4] : "";
+
+    std::vector<CorpusEntry> corpus = generateCorpus(nbrRandomScenarios, seed);
+    std::vector<std::vector<int>> diceSequences;
+    for (const CorpusEntry& entry : corpus) {
+        RNG rng(entry.scenario);
+        diceSequences.push_back(determineDiceSequence(rng));
+    }
+    int nbrPeriodic = std::count_if(diceSequences.begin(), diceSequences.end(), [](const std::vector<int>& d) {
+        return sequencePeriod(d) < DiceFingerprint::NBR_DICE;
+    });
+    std::cout << "Corpus: " << corpus.size() << " scenarios (seed " << seed << "), " << nbrPeriodic
+        << " with a period shorter than a game" << std::endl;
+
+    auto planSolver = [](std::function<GamePlan(const ScoreIndex&)> solve) {
+        return [solve](const std::vector<int>& diceSequence, bool& replayed) {
+            GamePlan plan = solve(ScoreIndex(diceSequence));
+            replayed = playPlan(diceSequence, plan) == plan.score;
+            return plan.score;
+        };
+    };
+    auto beam = [](int beamWidth) {
+        return [beamWidth](const ScoreIndex& index) { return solveBeam(index, BeamParams{beamWidth, 0}); };
+    };
+
+    // exact first: the other solvers are compared against it
+    SolverRun exact = runSolver("exact", planSolver(beam(0)), corpus, diceSequences);
+    printRun(exact, exact.scores, peakMemory());
+    std::vector<std::pair<std::string, Solver>> solvers = {
+        {"very greedy", planSolver(solveVeryGreedily)},
+        {"greedy", planSolver(solveGreedily)},
+        {"beam 100", planSolver(beam(100))},
+        {"beam 1000", planSolver(beam(1000))},
+        {"genetic " + std::to_string(nbrGenerations), [nbrGenerations](const std::vector<int>& diceSequence, bool& replayed) {
+            GParams params;
+            params.rejectDuplicates = true;
+            seedGenetic(1);
+            GState state(initializePopulation(diceSequence, params.populationSize, params.seedRatio, assignmentKernel(params)));
+            while (state.generationNbr < nbrGenerations) {
+                evolve(state, diceSequence, params);
+            }
+            // unplayable chromosomes are not reported as scores
+            const Chromosome* fittest = nullptr;
+            for (const Chromosome& c : state.population) {
+                if (isPlayable(c) && (!fittest || c.fitness > fittest->fitness)) {
+                    fittest = &c;
+                }
+            }
+            if (!fittest) {
+                replayed = false;
+                return 0;
+            }
+            // the rounds of the chromosome are played with the simulator and must reach its fitness
+            GamePlan plan = toGamePlan(*fittest, diceSequence, assignmentKernel(params));
+            replayed = plan.score == fittest->fitness && playPlan(diceSequence, plan) == plan.score;
+            return fittest->fitness;
+        }},
+#ifdef WITH_ILP
+        {"ilp", [](const std::vector<int>& diceSequence, bool& replayed) {
+            // a plan that is not proven optimal within the time limit is still reported
+            GamePlan plan = ILPSolver(diceSequence).solve(ILPParams{}).plan;
+            replayed = playPlan(diceSequence, plan) == plan.score;
+            return plan.score;
+        }},
+#endif
+    };
+    for (const auto& solver : solvers) {
+        printRun(runSolver(solver.first, solver.second, corpus, diceSequences), exact.scores, peakMemory());
+    }
+
+    // exact again, repeated dice sequences are answered by the result cache
+    ResultCache cache(cacheFile);
+    int nbrLoaded = cache.size();
+    SolverRun cached = runSolver("exact cached", [&cache](const std::vector<int>& diceSequence, bool& replayed) {
+        std::optional<GamePlan> plan = cache.lookup(diceSequence);
+        if (!plan) {
+            plan = solveBeam(diceSequence, BeamParams{0, 0});
+            cache.insert(diceSequence, *plan);
+        }
+        replayed = playPlan(diceSequence, *plan) == plan->score;
+        return plan->score;
+    }, corpus, diceSequences);
+    printRun(cached, exact.scores, peakMemory());
+    std::cout << "Result cache | " << nbrLoaded << " entries loaded, " << cache.hits() << " hits, " << cache.misses() << " misses" << std::endl;
+
+    // known answers
+    for (int i = 0; i < static_cast<int>(corpus.size()); ++i) {
+        if (corpus[i].expected >= 0) {
+            const Scenario& s = corpus[i].scenario;
+            std::cout << "alea.ans | " << s.A << " " << s.C << " " << s.X << ": expected " << corpus[i].expected
+                << ", exact " << exact.scores[i] << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "FitnessCache.h"
+#include "Genetic.h"
+
+#include <functional>
+
+namespace {
+
+const uint64_t fitnessMask = 0xffff;
+
+uint64_t mix(uint64_t x) {
+    // finalizer of splitmix64
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+/// tag stored in a slot: upper bits of the hash, never 0 so that 0 marks an empty slot
+uint64_t tagOf(uint64_t hash) {
+    return (hash & ~fitnessMask) | (1ull << 63);
+}
+}
+
+uint64_t hashChromosome(const Chromosome& c) {
+    uint64_t h = std::hash<chromT>()(c.chrom);
+    for (int geneGroup = 1; geneGroup <= 11; ++geneGroup) {
+        h = mix(h ^ static_cast<uint64_t>(c.intervals[geneGroup].second));
+    }
+    return h;
+}
+
+FitnessCache::FitnessCache(int log2Size) : m_slots(1ull << log2Size), m_indexMask((1ull << log2Size) - 1) {
+    for (auto& slot : m_slots) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool FitnessCache::lookup(uint64_t hash, int& fitness) {
+    uint64_t entry = m_slots[hash & m_indexMask].load(std::memory_order_relaxed);
+    if (entry != 0 && (entry & ~fitnessMask) == tagOf(hash)) {
+        fitness = entry & fitnessMask;
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void FitnessCache::insert(uint64_t hash, int fitness) {
+    m_slots[hash & m_indexMask].store(tagOf(hash) | (static_cast<uint64_t>(fitness) & fitnessMask), std::memory_order_relaxed);
+}
+
+double FitnessCache::hitRate() const {
+    uint64_t lookups = hits() + misses();
+    return lookups > 0 ? static_cast<double>(hits()) / lookups : 0.0;
+}
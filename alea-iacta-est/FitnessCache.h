@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+struct Chromosome;
+
+/* Fast hash of the dice selected by a chromosome: its bits and the borders of its gene groups */
+uint64_t hashChromosome(const Chromosome& c);
+
+/* Bounded fitness cache keyed by chromosome hash, shared by concurrent populations.
+ * The cache is a direct-mapped table: each slot is a single atomic word that packs a tag of the
+ * hash with the fitness, so lookups and inserts are lock-free. Colliding entries overwrite each other.
+ */
+class FitnessCache {
+public:
+    FitnessCache(int log2Size = 20);
+        /// creates a cache with 2^log2Size slots
+    bool lookup(uint64_t hash, int& fitness);
+        /// sets 'fitness' and returns true if a fitness is cached for 'hash'
+    void insert(uint64_t hash, int fitness);
+        /// caches the fitness for 'hash', replacing the entry in its slot
+    uint64_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+    double hitRate() const;
+        /// hits relative to all lookups
+private:
+    std::vector<std::atomic<uint64_t>> m_slots; // tag (upper 48 bits of the hash) | fitness (lower 16 bits), 0 if empty
+    uint64_t m_indexMask;
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+};
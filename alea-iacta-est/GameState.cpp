@@ -0,0 +1,69 @@
+#include "GameState.h"
+#include "Scorer.h"
+
+#include <cassert>
+
+Simulator::Simulator(const std::vector<int>& diceSequence) : m_sequenceLength(diceSequence.size()), m_state() {
+    assert(diceSequence.size() <= m_sequence.size() && "dice sequence too long");
+    for (int i = 0; i < m_sequenceLength; ++i) {
+        m_sequence[i] = diceSequence[i];
+    }
+}
+
+int Simulator::score(Combination c) const {
+    return scoreRoll(m_state.dice, c);
+}
+
+GameState Simulator::make(Move m) {
+    GameState previous = m_state;
+    switch (m.type) {
+        case MoveType::ROLL:
+            assert(m_state.cursor + 5 <= m_sequenceLength && "dice sequence exhausted");
+            for (int i = 0; i < 5; ++i) {
+                m_state.dice[i] = m_sequence[m_state.cursor++];
+            }
+            m_state.remainingReRolls = 2;
+            break;
+        case MoveType::REROLL:
+            assert(m_state.remainingReRolls > 0 && "At most two re-rolls allowed");
+            for (int i = 0; i < 5; ++i) {
+                if (m.arg & (1 << i)) {
+                    m_state.dice[i] = m_sequence[m_state.cursor++];
+                }
+            }
+            m_state.remainingReRolls -= 1;
+            break;
+        case MoveType::REGISTER: {
+            Combination c = static_cast<Combination>(m.arg);
+            assert(!m_state.hasEnded() && "Too many rolls!");
+            assert(!m_state.isUsed(c) && "cant register the same combination multiple times");
+            m_state.totalScore += score(c);
+            m_state.usedCombinations |= 1u << (m.arg - 1);
+            m_state.round += 1;
+            m_state.remainingReRolls = 0;
+            break;
+        }
+    }
+    return previous;
+}
+
+std::ostream& operator<<(std::ostream& os, const GamePlan& plan) {
+    for (const PlannedRound& r : plan.rounds) {
+        os << "dice " << r.start << ", re-roll " << static_cast<int>(r.firstReRoll) << " " << static_cast<int>(r.secondReRoll)
+           << ": " << r.combination << " " << r.score << "\n";
+    }
+    os << "Total score: " << plan.score;
+    return os;
+}
+
+int playPlan(const std::vector<int>& diceSequence, const GamePlan& plan) {
+    Simulator sim(diceSequence);
+    for (const PlannedRound& r : plan.rounds) {
+        if (sim.state().cursor != r.start) return -1;
+        sim.make({MoveType::ROLL, 0});
+        sim.make({MoveType::REROLL, r.firstReRoll});
+        sim.make({MoveType::REROLL, r.secondReRoll});
+        sim.make({MoveType::REGISTER, static_cast<uint8_t>(r.combination)});
+    }
+    return sim.state().totalScore;
+}
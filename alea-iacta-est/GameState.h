@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Common.h"
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/* Compact state of a game: fixed size, no allocations, trivially copyable.
+ * Used by search algorithms, Roll remains the verbose and validating front-end.
+ */
+struct GameState {
+    std::array<uint8_t, 5> dice;    // values of the current five dice
+    uint8_t cursor;                 // pos of the next dice in the dice sequence
+    uint8_t remainingReRolls;       // re-rolls left for the current dice
+    uint8_t round;                  // number of registered rolls
+    uint16_t usedCombinations;      // bit (combiId-1) is set if the combination has been scored
+    int16_t totalScore;
+    bool hasEnded() const { return round == 11; }
+    bool isUsed(Combination c) const { return usedCombinations & (1u << (static_cast<int>(c) - 1)); }
+};
+
+enum class MoveType : uint8_t {
+    ROLL,       // roll five new dice
+    REROLL,     // re-roll the dice in 'arg' (bit i: dice i)
+    REGISTER    // register the dice for combination 'arg'
+};
+
+struct Move {
+    MoveType type;
+    uint8_t arg;
+};
+
+/* Plays moves on a GameState for a known dice sequence.
+ * make() applies a move and returns the previous state, which unmake() restores.
+ * Moves are only checked by assertions.
+ */
+class Simulator {
+public:
+    Simulator(const std::vector<int>& diceSequence);
+    const GameState& state() const { return m_state; }
+    void setState(const GameState& state) { m_state = state; }
+    GameState make(Move m);
+        /// applies the move, returns the state before the move
+    void unmake(const GameState& previous) { m_state = previous; }
+        /// takes back the last move(s), 'previous' is the result of make()
+    int score(Combination c) const;
+        /// score of the current dice for combination 'c'
+    int sequenceLength() const { return m_sequenceLength; }
+private:
+    std::array<uint8_t, 11 * 6 * 3> m_sequence; // dice sequence of the RNG
+    int m_sequenceLength;
+    GameState m_state;
+};
+
+/* One round of a planned game: the dice at [start, start+5) are rolled, then re-rolled */
+struct PlannedRound {
+    int start;                  // pos of the first dice in the dice sequence
+    uint8_t firstReRoll;        // bit i: re-roll dice i
+    uint8_t secondReRoll;
+    Combination combination;
+    int score;
+};
+
+/* Moves of a whole game, as found by the solvers */
+struct GamePlan {
+    int score;
+    std::array<PlannedRound, 11> rounds;
+};
+
+std::ostream& operator<<(std::ostream& os, const GamePlan& plan);
+
+int playPlan(const std::vector<int>& diceSequence, const GamePlan& plan);
+    /// plays the plan with the simulator, returns the total score or -1 if a round starts at the wrong pos
@@ -2,12 +2,20 @@
 #include "Common.h"
 #include "Roll.h"
 #include "Scorer.h"
+#include "Selection.h"
+#include "Checkpoint.h"
+#include "ScoreIndex.h"
 
 #include <iostream>
 #include <algorithm>
 #include <numeric>
 #include <random>
 #include <cassert>
+#include <climits>
+#include <optional>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 // for recombination: only recombine "sets of five genes" that make up a dice roll so as to
 // ensure that jahtzee constraints hold
@@ -18,11 +26,129 @@
 
 namespace {
 
+/// random number engine of the calling thread, so that populations can evolve concurrently
+std::minstd_rand& randomEngine() {
+    thread_local std::minstd_rand engine;
+    return engine;
+}
+
+/// random number in [0, n)
+int randInt(int n) {
+    return randomEngine()() % n;
+}
+
 double randProb() {
-    return ((double)rand()/RAND_MAX);
+    return static_cast<double>(randomEngine()()) / std::minstd_rand::max();
+}
+
+/// mask with all bits at positions [0, n) set
+chromT lowMask(int n) {
+    return ~(~chromT() << n);
+}
+
+/// position of the n-th (0-based) set bit in 'bits'
+int nthSetBit(unsigned long bits, int n) {
+    while (n--) {
+        bits &= bits - 1; // clear lowest set bit
+    }
+    return __builtin_ctzl(bits);
+}
+
+/// plays a round starting at 'cursor' with re-roll masks 'm1' and 'm2' (bit i: re-roll dice i),
+/// stores the positions of the final dice in the sequence and returns the cursor after the round
+int playRound(int cursor, int m1, int m2, std::array<int, 5>& positions) {
+    for (int i = 0; i < 5; ++i) {
+        positions[i] = cursor++;
+    }
+    for (int mask : {m1, m2}) {
+        for (int i = 0; i < 5; ++i) {
+            if (mask & (1 << i)) {
+                positions[i] = cursor++;
+            }
+        }
+    }
+    return cursor;
+}
+
+/// bit 'genes' is set if the gene group 'genes' (bit i: dice i of the round) selects the final dice of
+/// some re-roll masks, rounds span at most 15 dice and end with the last re-rolled dice (the highest set bit)
+const std::bitset<1 << 15>& playableGroups() {
+    static const std::bitset<1 << 15> playable = []() {
+        std::bitset<1 << 15> p;
+        std::array<int, 5> positions;
+        for (int masks = 0; masks < 32 * 32; ++masks) {
+            playRound(0, masks >> 5, masks & 31, positions);
+            unsigned long genes = 0;
+            for (int pos : positions) {
+                genes |= 1ul << pos;
+            }
+            p.set(genes);
+        }
+        return p;
+    }();
+    return playable;
+}
+
+/// whether the genes of a gene group of length 'len' can be played as a round
+bool isPlayableGroup(unsigned long genes, int len) {
+    return len <= 15 && (genes >> (len - 1)) == 1 && playableGroups().test(genes);
 }
 }
 
+bool isPlayable(const Chromosome& c) {
+    int cursor = 0; // the rounds follow each other from the start of the dice sequence
+    for (int geneGroup = 1; geneGroup <= 11; ++geneGroup) {
+        const Interval& interval = c.intervals[geneGroup];
+        int len = interval.second - interval.first + 1;
+        if (interval.first != cursor || len < 5 || len > 15
+                || !isPlayableGroup(((c.chrom >> interval.first) & lowMask(len)).to_ulong(), len)) {
+            return false;
+        }
+        cursor = interval.second + 1;
+    }
+    return true;
+}
+
+GamePlan toGamePlan(const Chromosome& c, const std::vector<int>& diceSequence, AssignFn assign) {
+    assert(isPlayable(c));
+    // the assignment of 'c' may be outdated (fitness from a cache), it is computed from scratch
+    Chromosome scored = c;
+    scored.dirtyGroups = 0x7ff;
+    scored.updateGroupScores(diceSequence);
+    assign(scored.groupScores, 0x7ff, scored.assignment);
+    GamePlan plan;
+    plan.score = 0;
+    for (int combiId = 1; combiId <= 11; ++combiId) {
+        int geneGroup = scored.assignment.rowOfColumn[combiId-1] + 1;
+        const Interval& interval = c.intervals[geneGroup];
+        int len = interval.second - interval.first + 1;
+        unsigned long genes = ((c.chrom >> interval.first) & lowMask(len)).to_ulong();
+        // re-roll masks whose final dice are the genes of the group
+        std::array<int, 5> positions;
+        int masks = 0;
+        for (; masks < 32 * 32; ++masks) {
+            playRound(0, masks >> 5, masks & 31, positions);
+            unsigned long played = 0;
+            for (int pos : positions) {
+                played |= 1ul << pos;
+            }
+            if (played == genes) {
+                break;
+            }
+        }
+        assert(masks < 32 * 32);
+        int score = scored.groupScores[geneGroup-1][combiId-1];
+        plan.rounds[geneGroup-1] = {interval.first, static_cast<uint8_t>(masks >> 5), static_cast<uint8_t>(masks & 31),
+                                    static_cast<Combination>(combiId), score};
+        plan.score += score;
+    }
+    return plan;
+}
+
+void seedGenetic(unsigned int seed) {
+    randomEngine().seed(seed);
+}
+
 std::ostream& operator<<(std::ostream& os, const Chromosome& c) {
     os << c.chrom << "\n";
     int cLen = c.chrom.size();
@@ -53,7 +179,7 @@ std::ostream& operator<<(std::ostream& os, const Chromosome& c) {
 // other approach: if we remove a 1 -> gene group needs to expand
 // if we remove a 1 -> gene group needs to contract
 // TODO: still need to remove/add a 1 to fix the chromosome's number of 1's
-void Chromosome::mutateWithin(double mutProb, const std::vector<int>& diceSequence) {
+void Chromosome::mutateWithin(double mutProb, const std::vector<int>& diceSequence, FitnessCache* cache, AssignFn assign) {
     //TODO: implement me
     bool wasMutated = false;
     for (int i = 1; i <= 11; ++i) { // choose gene group (combination)
@@ -62,32 +188,44 @@ void Chromosome::mutateWithin(double mutProb, const std::vector<int>& diceSequen
         }
         const auto& interval = intervals[i];
         // check whether mutation within is possible -> at least one 0 needs to exist to allow for balance (same no of 1's remain)
-        std::vector<int> zeroIdx; 
-        std::vector<int> oneIdx;
-        for (int j = interval.first; j <= interval.second; ++j) {
-            if (chrom.test(j)) {
-                oneIdx.push_back(j);
-            } else {
-                zeroIdx.push_back(j);
+        // a gene group spans at most 15 bits, so it can be handled as a single word
+        int len = interval.second - interval.first + 1;
+        unsigned long groupMask = (1ul << len) - 1;
+        unsigned long genes = ((chrom >> interval.first) & lowMask(len)).to_ulong();
+        int nbrOnes = __builtin_popcountl(genes);
+        int nbrZeros = len - nbrOnes;
+        if (nbrZeros == 0) {
+            // all 1's -> cannot mutate anything within gene group
+            continue;
+        }
+        // select idx to mutate among the swaps (0 -> 1, 1 -> 0) that keep the gene group playable
+        std::array<std::pair<int, int>, 15 * 5> swaps;
+        int nbrSwaps = 0;
+        for (unsigned long zeros = ~genes & groupMask; zeros; zeros &= zeros - 1) {
+            for (unsigned long ones = genes; ones; ones &= ones - 1) {
+                unsigned long mutated = genes ^ (zeros & -zeros) ^ (ones & -ones);
+                if (isPlayableGroup(mutated, len)) {
+                    swaps[nbrSwaps++] = {__builtin_ctzl(zeros), __builtin_ctzl(ones)};
+                }
             }
         }
-        if (zeroIdx.size() == 0) {
-            // all 1's -> cannot mutate anything within gene group
+        if (nbrSwaps == 0) {
             continue;
         }
-        // select idx to mutate
-        int mutIdxZero = rand() % zeroIdx.size(); // change from 0 -> 1
-        int mutIdxOne = rand() % oneIdx.size(); // change from 1 -> 0
-        assert(!chrom.test(zeroIdx[mutIdxZero]));
-        assert(chrom.test(oneIdx[mutIdxOne]));
-        chrom.set(zeroIdx[mutIdxZero], true);
-        chrom.set(oneIdx[mutIdxOne], false);
+        auto swap = swaps[randInt(nbrSwaps)];
+        int mutIdxZero = interval.first + swap.first; // change from 0 -> 1
+        int mutIdxOne = interval.first + swap.second; // change from 1 -> 0
+        assert(!chrom.test(mutIdxZero));
+        assert(chrom.test(mutIdxOne));
+        chrom.set(mutIdxZero, true);
+        chrom.set(mutIdxOne, false);
+        markDirty(i);
         wasMutated = true;
         // std::cout << "Mutated!" << std::endl;
     }
     if (wasMutated) {
         // remember to update the fitness score of the chromosome if it has been mutated
-        score(diceSequence);
+        score(diceSequence, cache, assign);
     }
 }
 
@@ -96,12 +234,9 @@ void Chromosome::shiftLeft(int geneGroup, int by) {
         // no need to shift or correct intervals for following gene group
         return;
     }
-    // update chrom representation after geneGroup
-    auto oldChrom = chrom;
-    auto& pos = intervals.at(geneGroup+1);
-    for (int oldPos = pos.first; oldPos+by < chrom.size(); ++oldPos) {
-        chrom.set(oldPos+by, oldChrom.test(oldPos));
-    }
+    // update chrom representation after geneGroup: move everything from the next gene group on 'by' bits up
+    int start = intervals.at(geneGroup+1).first;
+    chrom = (chrom & lowMask(start)) | ((chrom & ~lowMask(start)) << by);
 }
 
 void Chromosome::shiftRight(int geneGroup, int by) {
@@ -110,20 +245,15 @@ void Chromosome::shiftRight(int geneGroup, int by) {
         // no need to shift or correct intervals for following gene groups because there are none
         return;
     }
-    // update chrom representation after geneGroup
-    auto oldChrom = chrom;
-    auto& pos = intervals.at(geneGroup+1);
-    for (int oldPos = pos.first; oldPos < chrom.size(); ++oldPos) {
-        chrom.set(oldPos+by, oldChrom.test(oldPos));
-    }
+    // update chrom representation after geneGroup: move everything from the next gene group on 'by' bits down
+    int start = intervals.at(geneGroup+1).first;
+    chrom = (chrom & lowMask(start + by)) | ((chrom & ~lowMask(start)) >> -by);
 }
 
 void Chromosome::replaceGeneGroup(int geneGroup, const Chromosome& other) {
     // find location in p1 
     auto p1int = other.intervals.at(geneGroup); // location in bitvector to select in p1
     auto childInt = intervals[geneGroup];
-    // iterate over posis: only first posi in child matters. the rest i can ignore ... will be overwritten ..
-    int childPos = childInt.first;
     // now: what has changed for all the following gene groups, i.e. gene groups with nbr > 'geneGroup'? 
     // if interval was reduced in child: e.g. from 10 elements to 5 elements -> all start/end pos following shrink by 5
     // if interval has increased in child: e.g. from 7 to 10 elements -> all start/end pos following increase by 3
@@ -133,9 +263,18 @@ void Chromosome::replaceGeneGroup(int geneGroup, const Chromosome& other) {
         // shift the following gene group bits to the left to make some space 
         shiftLeft(geneGroup, intervalChange);
     }
-    for (int i = p1int.first; i <= p1int.second; ++i) {
-        chrom.set(childPos, other.chrom.test(i));
-        childPos++;
+    // copy the gene group of p1 to the start of the child's gene group
+    int len = p1int.second - p1int.first + 1;
+    chromT genes = ((other.chrom >> p1int.first) & lowMask(len)) << childInt.first;
+    chrom = (chrom & ~(lowMask(len) << childInt.first)) | genes;
+
+    // the cached scores of p1 are still valid if the gene group stays at the same location in the dice sequence
+    if (childInt.first == p1int.first && !other.isDirty(geneGroup)) {
+        groupScores[geneGroup-1] = other.groupScores[geneGroup-1];
+        dirtyGroups &= ~(1u << (geneGroup-1));
+        changedGroups |= 1u << (geneGroup-1);
+    } else {
+        markDirty(geneGroup);
     }
 
     // std::cout << "geneGroup: " << geneGroup << ", interval difference: " << intervalChange << std::endl;
@@ -150,27 +289,31 @@ void Chromosome::replaceGeneGroup(int geneGroup, const Chromosome& other) {
         for (int i = geneGroup+1; i <= 11; ++i) {
             intervals[i].first += intervalChange;
             intervals[i].second += intervalChange;
+            if (intervalChange != 0) {
+                // shifted gene groups select other dice from the sequence
+                markDirty(i);
+            }
         }
     }
     //std::cout << *this << std::endl;
 }
 
 /// selects [s,e] from chromosome p 1, takes the rest from chromosome p2
-Chromosome createChild(const Chromosome& p1, const Chromosome& p2, int s, int e, const std::vector<int>& diceSequence) {
+Chromosome createChild(const Chromosome& p1, const Chromosome& p2, int s, int e, const std::vector<int>& diceSequence, FitnessCache* cache, AssignFn assign) {
     Chromosome child = p2;  
     for (int geneGroup = s; geneGroup <= e; ++geneGroup) {
         child.replaceGeneGroup(geneGroup, p1);
     }
-    child.score(diceSequence);
+    child.score(diceSequence, cache, assign);
     return child;
 }
 
-std::vector<Chromosome> recombine(const Chromosome& chrom1, const Chromosome& chrom2, const std::vector<int>& diceSequence) {
+std::vector<Chromosome> recombine(const Chromosome& chrom1, const Chromosome& chrom2, const std::vector<int>& diceSequence, FitnessCache* cache, AssignFn assign) {
     // 1. select breakpoint in chromosome in terms of combi idx (1 to 10)
-    int bp = rand() % 10 + 1;
+    int bp = randInt(10) + 1;
     // 2. produce children
-    Chromosome c1 = createChild(chrom1, chrom2, bp+1, 11, diceSequence);
-    Chromosome c2 = createChild(chrom1, chrom2, 1, bp, diceSequence);
+    Chromosome c1 = createChild(chrom1, chrom2, bp+1, 11, diceSequence, cache, assign);
+    Chromosome c2 = createChild(chrom1, chrom2, 1, bp, diceSequence, cache, assign);
     /*
     std::cout << "bp at: " << bp << ", parents are: " << std::endl;
     std::cout << chrom1 << std::endl;
@@ -222,34 +365,48 @@ int scoreChromosomeOld(Chromosome& chrom, const std::vector<int>& diceSequence)
     return totalScore;
 }
 
-// greedy scoring for each combination
-void Chromosome::score(const std::vector<int>& diceSequence) {
-    std::vector<int> remainingGeneGroups(11);
-    std::iota(remainingGeneGroups.begin(), remainingGeneGroups.end(), 1);
+void Chromosome::updateGroupScores(const std::vector<int>& diceSequence) {
+    std::vector<int> roll;
+    roll.reserve(5);
+    for (int geneGroup = 1; geneGroup <= 11; ++geneGroup) {
+        if (!isDirty(geneGroup)) {
+            continue;
+        }
+        const auto& interval = intervals[geneGroup];
+        roll.clear();
+        for (int j = interval.first; j <= interval.second; ++j) {
+            if (chrom.test(j)) {
+                roll.push_back(diceSequence[j]);
+            }
+        }
+        //printRoll(roll);
+        for (int combiId = 1; combiId <= 11; ++combiId) {
+            groupScores[geneGroup-1][combiId-1] = scoreRoll(roll, static_cast<Combination>(combiId));
+        }
+    }
+    dirtyGroups = 0;
+}
+
+int assignGreedily(const ScoreMatrix& scores, uint16_t /*changedRows*/, AssignmentState& state) {
+    int remainingGeneGroups = 0x7ff; // bit (geneGroup-1) is set if gene group is still unassigned
+    int unassignedCombis = 0; // bit (combiId-1) is set if no gene group scores for the combination
     int totalScore = 0;
     // order combinations from highest constraints/gain to lowest
     // order has an extremely high impact (e.g. shift of max score from 120 to 180 in genetic algo)
-    std::vector<Combination> combinations = {Combination::FIVE_OF_A_KIND,
+    static const Combination combinations[] = {Combination::FIVE_OF_A_KIND,
         Combination::FOUR_OF_A_KIND, Combination::FULL_HOUSE,
         Combination::SEQUENCE, Combination::SIXES, Combination::FIVES,
         Combination::FOURS, Combination::THREES, Combination::TWOS,
         Combination::ONES, Combination::CHANCE};
-    for (int combiId = 0; combiId < combinations.size(); ++combiId) {
-        Combination combi = combinations[combiId];
+    for (Combination combi : combinations) {
+        int combiIdx = static_cast<int>(combi) - 1;
         int maxScore = 0;
         int selGeneGroup = 0;
-        for (int i = 0; i < remainingGeneGroups.size(); ++i) {
-            int geneGroup = remainingGeneGroups[i];
-            const auto& interval = intervals[geneGroup];
-            std::vector<int> sel(diceSequence.begin() + interval.first, diceSequence.begin() + interval.second + 1);
-            std::vector<int> roll;
-            for (int j = interval.first; j <= interval.second; ++j) {
-                if (chrom.test(j)) {
-                    roll.push_back(diceSequence[j]);
-                }
+        for (int geneGroup = 1; geneGroup <= 11; ++geneGroup) {
+            if (!(remainingGeneGroups & (1 << (geneGroup-1)))) {
+                continue;
             }
-            //printRoll(roll);
-            int score = scoreRoll(roll, combi);
+            int score = scores[geneGroup-1][combiIdx];
             if (score >= maxScore) {
                 maxScore = score;    
                 selGeneGroup = geneGroup;
@@ -257,18 +414,278 @@ void Chromosome::score(const std::vector<int>& diceSequence) {
         }
         if (maxScore != 0) {
             // if combi cannot be found (score: 0) -> keep selected set in remaining groups to use these dice in a more meaningful way
-            remainingGeneGroups.erase(std::find(remainingGeneGroups.begin(), remainingGeneGroups.end(), selGeneGroup));
+            remainingGeneGroups &= ~(1 << (selGeneGroup-1));
+            state.rowOfColumn[combiIdx] = selGeneGroup-1;
+        } else {
+            unassignedCombis |= 1 << combiIdx;
         }
         //std::cout << "Max score for combination " << combi << " was: " << maxScore << std::endl;
         totalScore += maxScore;
     }
-    fitness = totalScore;
+    // the remaining gene groups score 0 for the remaining combinations
+    for (; unassignedCombis; unassignedCombis &= unassignedCombis - 1) {
+        int geneGroupIdx = __builtin_ctz(remainingGeneGroups);
+        remainingGeneGroups &= remainingGeneGroups - 1;
+        state.rowOfColumn[__builtin_ctz(unassignedCombis)] = geneGroupIdx;
+    }
+    return totalScore;
+}
+
+namespace {
+
+#if defined(__x86_64__) || defined(__i386__)
+bool cpuHasAvx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+/// costs 'MAX_ROLL_SCORE - score' of a row, one 16 bit lane per combination (lanes 11 to 15 are unused)
+__attribute__((target("avx2")))
+__m256i rowCosts(const ScoreMatrix& scores, int row) {
+    // 16 byte loads within the 121 bytes of the matrix, the last row is loaded with the end of the row before
+    const uint8_t* first = scores[0].data();
+    __m128i bytes = row < 10 ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + 11 * row))
+                             : _mm_srli_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + 105)), 5);
+    return _mm256_sub_epi16(_mm256_set1_epi16(MAX_ROLL_SCORE), _mm256_cvtepu8_epi16(bytes));
+}
+
+constexpr int MAX_LANE_VALUE = 0xFFF;
+
+/// smallest of the lanes 'x' that are not 'excluded' (x is non-negative), 'lane' is the first lane holding it.
+/// Values above MAX_LANE_VALUE are saturated: the lane number is kept in the low 4 bits of the 16 bit lanes
+__attribute__((target("avx2")))
+int minLane(__m256i x, __m256i excluded, int& lane) {
+    const __m256i lanes = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m256i keys = _mm256_or_si256(_mm256_slli_epi16(_mm256_min_epu16(x, _mm256_set1_epi16(MAX_LANE_VALUE)), 4), lanes);
+    keys = _mm256_or_si256(keys, excluded);
+    int key = _mm_cvtsi128_si32(_mm_minpos_epu16(_mm_min_epu16(_mm256_castsi256_si128(keys), _mm256_extracti128_si256(keys, 1))));
+    lane = key & 15;
+    return (key & 0xFFFF) >> 4;
+}
+
+/// assignOptimally with one 16 bit lane per column: each step of an augmenting path relaxes all columns at once
+/// and picks the next one by a horizontal minimum. The potentials are updated once per path
+/// (by the distances of the reached columns) instead of once per step.
+/// Returns -1 without changing 'state' if a distance does not fit into a lane (MAX_LANE_VALUE).
+__attribute__((target("avx2")))
+int assignOptimallyAvx2(const ScoreMatrix& scores, uint16_t changedRows, AssignmentState& state) {
+    const int n = 11;
+    const __m256i lanes = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m256i padding = _mm256_cmpgt_epi16(lanes, _mm256_set1_epi16(n - 1)); // lanes 11 to 15
+    int match[n]; // row assigned to column, -1: none
+    int columnOfRow[n]; // -1: none
+    int u[n] = {0}; // potential of rows
+    __m256i v = _mm256_setzero_si256(); // potential of columns
+    std::fill(match, match + n, -1);
+    std::fill(columnOfRow, columnOfRow + n, -1);
+    if (changedRows != 0x7ff) { // otherwise 'state' may be uninitialized
+        // 16 bytes from the start of 'state', the lanes after the 11 column potentials are unused
+        v = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state.columnPotential.data())));
+        for (int j = 0; j < n; ++j) {
+            int row = state.rowOfColumn[j];
+            if (!(changedRows & (1u << row))) {
+                match[j] = row;
+                columnOfRow[row] = j;
+                u[row] = state.rowPotential[row];
+            }
+        }
+    }
+    // v only decreases from at most 0, so reduced costs and distances are non-negative (unsigned minimum)
+    for (uint16_t rows = changedRows; rows; rows &= rows - 1) {
+        int i = __builtin_ctz(rows);
+        int lane;
+        u[i] = minLane(_mm256_sub_epi16(rowCosts(scores, i), v), padding, lane);
+        if (u[i] == MAX_LANE_VALUE) {
+            return -1;
+        }
+    }
+    for (uint16_t rows = changedRows; rows; rows &= rows - 1) {
+        const int start = __builtin_ctz(rows);
+        __m256i dist = _mm256_set1_epi16(MAX_LANE_VALUE); // shortest distance to each column found so far
+        __m256i pred = _mm256_set1_epi16(-1); // row before each column on the shortest path
+        __m256i reached = padding; // columns whose distance is final
+        int visited[n]; // rows on the shortest path tree, with their distances
+        int visitedDist[n];
+        int nbrVisited = 0;
+        int row = start, rowDist = 0;
+        int freeColumn, freeDist;
+        for (;;) {
+            visited[nbrVisited] = row;
+            visitedDist[nbrVisited++] = rowDist;
+            __m256i reduced = _mm256_sub_epi16(_mm256_add_epi16(rowCosts(scores, row), _mm256_set1_epi16(rowDist - u[row])), v);
+            __m256i shorter = _mm256_andnot_si256(reached, _mm256_cmpgt_epi16(dist, reduced));
+            dist = _mm256_blendv_epi8(dist, reduced, shorter);
+            pred = _mm256_blendv_epi8(pred, _mm256_set1_epi16(row), shorter);
+            int j;
+            int d = minLane(dist, reached, j);
+            if (d == MAX_LANE_VALUE) {
+                return -1;
+            }
+            reached = _mm256_or_si256(reached, _mm256_cmpeq_epi16(lanes, _mm256_set1_epi16(j)));
+            if (match[j] < 0) {
+                freeColumn = j;
+                freeDist = d;
+                break;
+            }
+            row = match[j];
+            rowDist = d;
+        }
+        // potentials: the reached columns and the visited rows move by their distance to the free column
+        __m256i reachedColumns = _mm256_andnot_si256(padding, reached);
+        v = _mm256_sub_epi16(v, _mm256_and_si256(reachedColumns, _mm256_sub_epi16(_mm256_set1_epi16(freeDist), dist)));
+        for (int k = 0; k < nbrVisited; ++k) {
+            u[visited[k]] += freeDist - visitedDist[k];
+        }
+        // augment along the path
+        alignas(32) int16_t predRow[16];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(predRow), pred);
+        for (int j = freeColumn; ; ) {
+            int i = predRow[j];
+            int next = columnOfRow[i];
+            match[j] = i;
+            columnOfRow[i] = j;
+            if (i == start) break;
+            j = next;
+        }
+    }
+    alignas(32) int16_t columnPotential[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(columnPotential), v);
+    // shifting the potentials to max(v) = 0 keeps u in [0, MAX_ROLL_SCORE] and v in [-MAX_ROLL_SCORE, 0]
+    int shift = *std::max_element(columnPotential, columnPotential + n);
+    int totalScore = 0;
+    for (int j = 0; j < n; ++j) {
+        totalScore += scores[match[j]][j];
+        state.rowOfColumn[j] = match[j];
+        state.columnPotential[j] = columnPotential[j] - shift;
+        state.rowPotential[j] = u[j] + shift;
+    }
+    return totalScore;
+}
+#endif
+
+}
+
+int assignOptimally(const ScoreMatrix& scores, uint16_t changedRows, AssignmentState& state) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (cpuHasAvx2()) {
+        int totalScore = assignOptimallyAvx2(scores, changedRows, state);
+        if (totalScore >= 0) {
+            return totalScore;
+        }
+    }
+#endif
+    // Hungarian algorithm for the 11x11 assignment of gene groups (rows) to combinations (columns).
+    // The costs 'MAX_ROLL_SCORE - score' are minimized (all non-negative), which maximizes the total score.
+    // An exact bitmask DP over subsets of gene groups (O(11 * 2^11)) took 20-100 us per matrix, the Hungarian algorithm ~1 us.
+    // A mutation changes one gene group and a recombination the gene groups from its crossover point on, so the algorithm
+    // starts from the potentials and the matching of 'state': the changed rows are unmatched, their potentials lowered
+    // until they are feasible again, and each of them is added back by one augmenting path in O(n^2).
+    // Arrays are 1-based, column 0 is a virtual column used to start augmenting paths.
+    const int n = 11;
+    const bool fresh = changedRows == 0x7ff; // 'state' may be uninitialized
+    int u[n+1] = {0}; // potential of rows
+    int v[n+1] = {0}; // potential of columns
+    int match[n+1] = {0}; // row assigned to column
+    int way[n+1] = {0}; // previous column on the augmenting path
+    if (!fresh) {
+        for (int j = 1; j <= n; ++j) {
+            v[j] = state.columnPotential[j-1];
+            int row = state.rowOfColumn[j-1];
+            if (!(changedRows & (1u << row))) {
+                match[j] = row + 1;
+                u[row + 1] = state.rowPotential[row];
+            }
+        }
+    }
+    for (uint16_t rows = changedRows; rows; rows &= rows - 1) {
+        int i = __builtin_ctz(rows) + 1;
+        u[i] = INT_MAX;
+        for (int j = 1; j <= n; ++j) {
+            u[i] = std::min(u[i], MAX_ROLL_SCORE - scores[i-1][j-1] - v[j]);
+        }
+    }
+    for (uint16_t rows = changedRows; rows; rows &= rows - 1) {
+        int i = __builtin_ctz(rows) + 1;
+        match[0] = i;
+        int j0 = 0;
+        int minv[n+1];
+        bool used[n+1];
+        std::fill(minv, minv + n + 1, INT_MAX);
+        std::fill(used, used + n + 1, false);
+        do {
+            used[j0] = true;
+            int i0 = match[j0];
+            int delta = INT_MAX;
+            int j1 = 0;
+            const auto& row = scores[i0-1];
+            for (int j = 1; j <= n; ++j) {
+                if (used[j]) {
+                    continue;
+                }
+                int cur = MAX_ROLL_SCORE - row[j-1] - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= n; ++j) {
+                if (used[j]) {
+                    u[match[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (match[j0] != 0);
+        // augment along the path
+        do {
+            int j1 = way[j0];
+            match[j0] = match[j1];
+            j0 = j1;
+        } while (j0);
+    }
+    // shifting the potentials to max(v) = 0 keeps u in [0, MAX_ROLL_SCORE] and v in [-MAX_ROLL_SCORE, 0]
+    int shift = *std::max_element(v + 1, v + n + 1);
+    int totalScore = 0;
+    for (int j = 1; j <= n; ++j) {
+        totalScore += scores[match[j]-1][j-1];
+        state.rowOfColumn[j-1] = match[j] - 1;
+        state.columnPotential[j-1] = v[j] - shift;
+        state.rowPotential[j-1] = u[j] + shift;
+    }
+    return totalScore;
 }
 
-Chromosome createChromosome(const std::vector<int>& diceSequence) {
+// assignment of gene groups to combinations by 'assign'
+void Chromosome::score(const std::vector<int>& diceSequence, FitnessCache* cache, AssignFn assign) {
+    uint64_t hash = 0;
+    if (cache) {
+        hash = hashChromosome(*this);
+        if (cache->lookup(hash, fitness)) {
+            // dirty gene groups stay dirty: their scores are updated once they are needed
+            return;
+        }
+    }
+    uint16_t changed = changedGroups | dirtyGroups;
+    updateGroupScores(diceSequence);
+    fitness = assign(groupScores, changed, assignment);
+    changedGroups = 0;
+    if (cache) {
+        cache->insert(hash, fitness);
+    }
+}
+
+Chromosome createChromosome(const std::vector<int>& diceSequence, AssignFn assign) {
     int nbrOfOnes = 11*5; 
     chromT chromosome;
     Chromosome chrom;
+    chrom.dirtyGroups = 0x7ff; // all gene groups need to be scored
+    chrom.changedGroups = 0x7ff;
     Roll rollSequence(diceSequence);
 
     // randomly select ones, fulfilling constraints
@@ -299,9 +716,9 @@ Chromosome createChromosome(const std::vector<int>& diceSequence) {
                 std::vector<int> availableIndices(5); // available indices for a reroll
                 std::iota(availableIndices.begin(), availableIndices.end(), 0); // 0 to 4
                 while (nbrRerolls--) { 
-                    int idx = rand() % availableIndices.size();
+                    int idx = randInt(availableIndices.size());
                     while (std::find(availableIndices.begin(), availableIndices.end(), idx) == availableIndices.end()) {
-                        idx = rand() % availableIndices.size(); // resample: ugly but ok
+                        idx = randInt(availableIndices.size()); // resample: ugly but ok
                     }
                     idxToReroll.push_back(availableIndices[idx]);
                     availableIndices[idx] = -1; // make element 'unavailable'
@@ -325,22 +742,89 @@ Chromosome createChromosome(const std::vector<int>& diceSequence) {
         }
         int newi = *std::max_element(usedIdx.begin(), usedIdx.end()) + 1;
         // store interval of selected elements in the dice sequence
-        std::pair<int,int> interval = std::make_pair(initiali, newi - 1);
-        chrom.intervals[abs(nbrMoves - 11)] = interval;
+        chrom.intervals[abs(nbrMoves - 11)] = {initiali, newi - 1};
         i = newi;
     }
     chrom.chrom = chromosome; 
 
     // determine score of chromosome
-    chrom.score(diceSequence);
+    chrom.score(diceSequence, nullptr, assign);
     return chrom;
 }
 
-std::vector<Chromosome> initializePopulation(const std::vector<int>& diceSequence, int populationSize) {
+
+Chromosome createSeededChromosome(const ScoreIndex& index, const std::vector<int>& diceSequence, SeedStrategy strategy, double randomness, AssignFn assign) {
+    Chromosome chrom;
+    chrom.dirtyGroups = 0x7ff; // all gene groups need to be scored
+    chrom.changedGroups = 0x7ff;
+    int remainingCombis = 0x7ff; // bit (combiId-1) is set if the combination has not been scored yet
+    int cursor = 0; // pos of next dice in diceSequence
+    std::array<uint8_t, 5> roll;
+    std::array<int, 5> positions;
+    for (int geneGroup = 1; geneGroup <= 11; ++geneGroup) {
+        int bestScore = -1;
+        int bestLength = 0;
+        int bestCombi = 0;
+        std::pair<int, int> bestMasks; // (first re-roll, second re-roll)
+        if (randProb() < randomness) {
+            // deviate from the strategy so that seeds differ. GREEDY: skip the window by re-rolling all dice
+            bestMasks = strategy == SeedStrategy::GREEDY ? std::make_pair(31, 0) : std::make_pair(randInt(32), randInt(32));
+            bestLength = playRound(cursor, bestMasks.first, bestMasks.second, positions) - cursor;
+            for (int i = 0; i < 5; ++i) {
+                roll[i] = diceSequence[positions[i]];
+            }
+            for (int combiId = 1; combiId <= 11; ++combiId) {
+                int score = scoreRoll(roll, static_cast<Combination>(combiId));
+                if ((remainingCombis & (1 << (combiId-1))) && score > bestScore) {
+                    bestScore = score;
+                    bestCombi = combiId;
+                }
+            }
+        } else {
+            // GREEDY: no re-rolls, WINDOW: best re-roll masks of any length
+            int maxLength = strategy == SeedStrategy::GREEDY ? 5 : MAX_ROUND_LENGTH;
+            for (int length = 5; length <= maxLength && cursor + length <= index.sequenceLength(); ++length) {
+                for (int combiId = 1; combiId <= 11; ++combiId) {
+                    const RoundOption& o = index.option(cursor, length, combiId);
+                    // prefer higher scores, then rounds which use fewer dice
+                    if ((remainingCombis & (1 << (combiId-1))) && o.score > bestScore) {
+                        bestScore = o.score;
+                        bestLength = length;
+                        bestCombi = combiId;
+                        bestMasks = {o.firstReRoll, o.secondReRoll};
+                    }
+                }
+            }
+        }
+        playRound(cursor, bestMasks.first, bestMasks.second, positions);
+        for (int pos : positions) {
+            chrom.chrom.set(pos);
+        }
+        chrom.intervals[geneGroup] = {cursor, cursor + bestLength - 1};
+        if (bestScore > 0) {
+            remainingCombis &= ~(1 << (bestCombi-1));
+        }
+        cursor += bestLength;
+    }
+    chrom.score(diceSequence, nullptr, assign);
+    return chrom;
+}
+
+std::vector<Chromosome> initializePopulation(const std::vector<int>& diceSequence, int populationSize, double seedRatio, AssignFn assign) {
     std::vector<Chromosome> pop(populationSize);
+    int nbrSeeds = static_cast<int>(seedRatio * populationSize + 0.5);
+    std::optional<ScoreIndex> index;
+    if (nbrSeeds > 0) {
+        index.emplace(diceSequence);
+    }
     for (int i = 0; i < populationSize; ++i) {
-       pop[i] = createChromosome(diceSequence);
-       std::cout << pop[i] << std::endl;
+        if (i < nbrSeeds) {
+            // alternate the strategies, the first seed of each strategy follows the strategy strictly
+            SeedStrategy strategy = i % 2 == 0 ? SeedStrategy::GREEDY : SeedStrategy::WINDOW;
+            pop[i] = createSeededChromosome(*index, diceSequence, strategy, i < 2 ? 0.0 : 0.2, assign);
+        } else {
+            pop[i] = createChromosome(diceSequence, assign);
+        }
     }
     return pop;
 }
@@ -355,44 +839,154 @@ bool compareChromosome(const Chromosome& c1, const Chromosome& c2) {
     return c1.fitness > c2.fitness;
 }
 
-void removeLeastFit(std::vector<Chromosome>& population, int nRemove) {
-    // ... could also have the population be always sorted (prio queue) .. TODO?
-    sort(population.begin(), population.end(), compareChromosome);
-    population.erase(population.end()-nRemove, population.end());
+GState::GState(std::vector<Chromosome> initialPopulation, int generationNbr) :
+    population(std::move(initialPopulation)), generationNbr(generationNbr), lastImprovement(generationNbr) {
+    leastFit.build(population);
+    for (const Chromosome& c : population) {
+        memberHashes[hashChromosome(c)] += 1;
+    }
+    fittest = std::min_element(population.begin(), population.end(), compareChromosome) - population.begin();
+}
+
+bool replaceLeastFit(GState& state, const Chromosome& c, bool rejectDuplicates) {
+    // steady state selection: the least fit member is replaced in O(log P), the population is never sorted
+    if (c.fitness < state.leastFit.minFitness()) {
+        return false;
+    }
+    uint64_t hash = hashChromosome(c);
+    if (rejectDuplicates && state.memberHashes.count(hash)) {
+        return false; // keep the population diverse
+    }
+    int slot = state.leastFit.leastFit();
+    auto replacedIt = state.memberHashes.find(hashChromosome(state.population[slot]));
+    if (--replacedIt->second == 0) {
+        state.memberHashes.erase(replacedIt);
+    }
+    state.memberHashes[hash] += 1;
+    state.population[slot] = c;
+    state.leastFit.update(slot, c.fitness);
+    if (c.fitness > state.population[state.fittest].fitness) {
+        state.fittest = slot;
+        state.lastImprovement = state.generationNbr;
+    }
+    return true;
 }
 
-void mutateWithin(std::vector<Chromosome>& population, double mutProb, const std::vector<int>& diceSequence) {
+std::vector<Chromosome> selectFittest(const GState& state, int n) {
+    std::vector<Chromosome> fittest(std::min<size_t>(n, state.population.size()));
+    std::partial_sort_copy(state.population.begin(), state.population.end(),
+                           fittest.begin(), fittest.end(), compareChromosome);
+    return fittest;
+}
+
+void immigrate(GState& state, const std::vector<Chromosome>& migrants, bool rejectDuplicates) {
+    // migrants compete with the current population: population size stays constant
+    for (const Chromosome& c : migrants) {
+        replaceLeastFit(state, c, rejectDuplicates);
+    }
+}
+
+void mutateWithin(std::vector<Chromosome>& population, double mutProb, const std::vector<int>& diceSequence, FitnessCache* cache, AssignFn assign) {
     for (Chromosome& c : population) {
-        c.mutateWithin(mutProb, diceSequence);
+        c.mutateWithin(mutProb, diceSequence, cache, assign);
     }
 }
 
-void solveGenetic(const std::vector<int>& diceSequence, GParams params) {
-    std::vector<Chromosome> population = initializePopulation(diceSequence, params.populationSize);
-    std::cout << "Population initialized!" << std::endl << std::flush;
-    int iteration = 0;
+AssignFn assignmentKernel(const GParams& params) {
+    return params.exactAssignment ? assignOptimally : assignGreedily;
+}
+
+void evolve(GState& state, const std::vector<int>& diceSequence, const GParams& params) {
+    std::vector<Chromosome>& population = state.population;
+    // 1. Recombination
+    // select pair of parents by tournaments (referenced by index)
+    //std::cout << "Population size is: " << population.size() << std::endl;
+    //printPopulation(population);
+    int idx1 = selectByTournament(population, params.tournamentSize, randomEngine());
+    int idx2 = selectByTournament(population, params.tournamentSize, randomEngine()); // TODO: re-choose if the same
+    std::vector<Chromosome> children = recombine(population[idx1], population[idx2], diceSequence, params.fitnessCache, assignmentKernel(params));
+    // 2. Mutation on children
+    mutateWithin(children, params.mutationProb, diceSequence, params.fitnessCache, assignmentKernel(params));
+
+    // 3. Selection
+    // Idea: children replace the least fit individual(s). the population size stays constant
+    for (const auto& c : children) {
+        replaceLeastFit(state, c, params.rejectDuplicates);
+    }
+    state.generationNbr += 1;
+}
+
+std::ostream& operator<<(std::ostream& os, const Telemetry& t) {
+    os << "Generation " << t.generationNbr << " | max fitness: " << t.maxFitness
+       << " | mean fitness: " << t.meanFitness << " | diversity: " << t.diversity;
+    return os;
+}
+
+Telemetry collectTelemetry(const GState& state) {
+    const auto& population = state.population;
+    long totalFitness = 0;
+    std::array<int, 15*11> onesPerBit = {0}; // how many chromosomes use each dice
+    for (const Chromosome& c : population) {
+        totalFitness += c.fitness;
+        int cLen = c.chrom.size();
+        for (int j = 0; j < cLen; ++j) {
+            onesPerBit[j] += c.chrom.test(j);
+        }
+    }
+    // the sum of hamming distances over all pairs is the sum over all bits of (#ones * #zeros)
+    double p = population.size();
+    double pairwiseDistance = 0;
+    for (int ones : onesPerBit) {
+        pairwiseDistance += static_cast<double>(ones) * (p - ones);
+    }
+    double nbrPairs = p * (p - 1) / 2;
+    double diversity = nbrPairs > 0 ? pairwiseDistance / nbrPairs / onesPerBit.size() : 0.0;
+    return {state.generationNbr, population[state.fittest].fitness, totalFitness / p, diversity};
+}
+
+bool shouldStop(const GState& state, const GParams& params, std::chrono::steady_clock::time_point start) {
+    if (params.maxGenerations > 0 && state.generationNbr >= params.maxGenerations) {
+        return true;
+    }
+    if (params.stagnationWindow > 0 && state.generationNbr - state.lastImprovement >= params.stagnationWindow) {
+        return true;
+    }
+    if (params.timeLimit > 0) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() >= params.timeLimit;
+    }
+    return false;
+}
+
+Chromosome solveGenetic(const std::vector<int>& diceSequence, GParams params) {
+    auto start = std::chrono::steady_clock::now();
+    std::optional<GState> checkpoint;
+    if (!params.checkpointFile.empty()) {
+        checkpoint = loadCheckpoint(params.checkpointFile, diceSequence, params.populationSize);
+    }
+    GState state = checkpoint ? std::move(*checkpoint) : GState(initializePopulation(diceSequence, params.populationSize, params.seedRatio, assignmentKernel(params)));
+    if (checkpoint) {
+        std::cout << "Resumed from checkpoint at generation " << state.generationNbr << std::endl;
+    } else {
+        std::cout << "Population initialized!" << std::endl;
+    }
     /////// START
-    while (true) { // TODO: stop based on change in fitness between iterations and nbr of iterations
-        // 1. Recombination
-        // select random pair of parents
-        //std::cout << "Population size is: " << population.size() << std::endl;
-        //printPopulation(population);
-        int idx1 = rand() % population.size();
-        int idx2 = rand() % population.size(); // TODO: re-choose if the same
-        std::vector<Chromosome> children = recombine(population[idx1], population[idx2], diceSequence);
-        // 2. Mutation on children
-        mutateWithin(children, params.mutationProb, diceSequence);
-        // add children to population
-        for (const auto& c : children) {
-            population.push_back(c);
-        }
-
-        // 3. Selection
-        // Idea: just remove the least fit individual(s). for constant population size: always remove the 2 least fit members
-        // TODO use this as param in GParams
-        int nRemove = 2;
-        removeLeastFit(population, nRemove); // TODO: improve scoring
-        iteration += 1;
-        std::cout << "Iteration " << iteration << ", max fitness: " << population[0].fitness << std::endl;
+    while (!shouldStop(state, params, start)) {
+        evolve(state, diceSequence, params);
+        if (params.telemetryInterval > 0 && state.generationNbr % params.telemetryInterval == 0) {
+            state.telemetry.push_back(collectTelemetry(state));
+            std::cout << state.telemetry.back() << "\n";
+        }
+        if (!params.checkpointFile.empty() && state.generationNbr % params.checkpointInterval == 0) {
+            saveCheckpoint(params.checkpointFile, state, diceSequence);
+        }
+    }
+    if (!params.checkpointFile.empty()) {
+        saveCheckpoint(params.checkpointFile, state, diceSequence);
+    }
+    std::cout << collectTelemetry(state) << std::endl;
+    if (params.fitnessCache) {
+        std::cout << "Fitness cache hit rate: " << params.fitnessCache->hitRate() << std::endl;
     }
+    return state.population[state.fittest];
 }
@@ -1,12 +1,48 @@
 #pragma once
 
 #include <vector>
+#include <array>
 #include <bitset>
-#include <unordered_map>
+#include <cstdint>
 #include <iostream>
+#include <type_traits>
+#include <string>
+#include <chrono>
+#include <unordered_map>
+
+#include "Selection.h"
+#include "FitnessCache.h"
+#include "ScoreIndex.h"
+#include "GameState.h"
 
 using chromT = std::bitset<15*11>;
 
+/// score of each gene group (row) for each combination (column)
+using ScoreMatrix = std::array<std::array<uint8_t, 11>, 11>;
+
+/// assignment of gene groups to combinations, kept with the chromosome between scorings
+struct AssignmentState {
+    std::array<int8_t, 11> columnPotential; // dual variables of assignOptimally, in [-MAX_ROLL_SCORE, 0]
+    std::array<int8_t, 11> rowPotential; // in [0, MAX_ROLL_SCORE]
+    std::array<uint8_t, 11> rowOfColumn; // gene group (0 to 10) assigned to each combination (0 to 10)
+};
+
+/// assigns gene groups to combinations greedily in a fixed order of combinations, returns the total score
+int assignGreedily(const ScoreMatrix& scores, uint16_t changedRows, AssignmentState& state);
+/// assigns gene groups to combinations such that the total score is maximal, returns the total score.
+/// Only the rows in 'changedRows' (bit row) differ from the matrix that 'state' was computed for,
+/// each of them costs one augmenting path of the Hungarian algorithm (all 11 on the first scoring)
+int assignOptimally(const ScoreMatrix& scores, uint16_t changedRows, AssignmentState& state);
+
+/// kernel that computes the fitness from the score matrix of a chromosome and updates its assignment
+using AssignFn = int (*)(const ScoreMatrix& scores, uint16_t changedRows, AssignmentState& state);
+
+/// closed interval [first, second] in the dice sequence
+struct Interval {
+    int first;
+    int second;
+};
+
 
 /* A chromosome represents a sequence of decisions in the 11*15 long
  * sequence of possible dice rolls of the random number generator.
@@ -16,21 +52,47 @@ using chromT = std::bitset<15*11>;
  * Since there are 11 combinations to be selected (for each of which 3 rolls can be performed at most)
  * each of the areas in the chromosome are delineated according to the combination borders.
  * e.g. |01100111| has the interval [0, 7]
+ *
+ * The chromosome is trivially copyable (no heap allocations) so that populations
+ * can be stored in one contiguous buffer and copied cheaply.
+ *
+ * The score of each gene group for each combination is cached. Operations that change
+ * the dice selected by a gene group mark it as dirty, so that re-scoring only
+ * re-evaluates the changed gene groups before assigning groups to combinations.
+ * The fitness is the score of an assignment of gene groups to combinations, by default the optimal one
+ * (assignOptimally), which starts from the assignment of the previous scoring (inherited by children),
+ * or the greedy one (assignGreedily).
  */ 
 struct Chromosome {
     chromT chrom; /// the vector of dice rolls (1/0) representing the chromosome
-    std::unordered_map<int, std::pair<int,int>> intervals; // map from combination (1 to 11) to closed interval in the dice sequence ('chrom')
+    std::array<Interval, 12> intervals; // combination (1 to 11) to closed interval in the dice sequence ('chrom'), idx 0 is unused
     int fitness; // fitness in terms of yahtzee points earned
+    ScoreMatrix groupScores; // cached score of gene group (row, 1 to 11 -> 0 to 10) for each combination (column)
+    uint16_t dirtyGroups; // bit (geneGroup-1) is set if the row of 'geneGroup' in 'groupScores' is outdated
+    uint16_t changedGroups; // bit (geneGroup-1) is set if the row of 'geneGroup' changed since 'assignment' was computed
+    AssignmentState assignment; // assignment of the last scoring
+    void markDirty(int geneGroup) { dirtyGroups |= 1u << (geneGroup-1); }
+    bool isDirty(int geneGroup) const { return dirtyGroups & (1u << (geneGroup-1)); }
     void replaceGeneGroup(int geneGroup, const Chromosome& other); // replaces geneGroup with gene group from other
     void shiftLeft(int geneGroup, int by); // shift entries to the left which are greater than gene group
     void shiftRight(int geneGroup, int by); // shift entries to the right which are greater than gene group
-    void score(const std::vector<int>& diceSequence); // determine fitness
-    void mutateWithin(double mutProb, const std::vector<int>& diceSequence); // mutates gene group with 'mutProb' probability
+    void score(const std::vector<int>& diceSequence, FitnessCache* cache = nullptr, AssignFn assign = assignOptimally); // determine fitness, looked up in 'cache' if given
+    void updateGroupScores(const std::vector<int>& diceSequence); // re-scores the dirty gene groups
+    void mutateWithin(double mutProb, const std::vector<int>& diceSequence, FitnessCache* cache = nullptr, AssignFn assign = assignOptimally); // mutates gene group with 'mutProb' probability
     // TODO: mutateAnywhere() | may change reading frame
 };
+static_assert(std::is_trivially_copyable<Chromosome>::value, "Chromosome should be cheap to copy");
 
 std::ostream& operator<<(std::ostream& os, const Chromosome& c);
 
+/// whether the rounds of 'c' can be played: consecutive gene groups from the start of the dice sequence,
+/// each selecting the final dice of some re-roll masks and ending with the last re-rolled dice
+bool isPlayable(const Chromosome& c);
+
+/// rounds of the playable chromosome 'c' as a plan for playPlan, each gene group registered for the
+/// combination assigned to it by 'assign' (the plan's score is the fitness of 'c' unless a cache mixed kernels)
+GamePlan toGamePlan(const Chromosome& c, const std::vector<int>& diceSequence, AssignFn assign = assignOptimally);
+
 // for recombination: only recombine "sets of five genes" that make up a dice roll so as to
 // ensure that jahtzee constraints hold
 // only recombine in the area where both values have something other than 0s (left bit vector is mostly 0)
@@ -38,7 +100,8 @@ std::ostream& operator<<(std::ostream& os, const Chromosome& c);
 // -> need to have a function to select the blocks (5 grouping) ...
 // blocks are dynamic so this is just a getter: getblock(int blockNr) -> interval (i,j)
 
-std::vector<Chromosome> recombine(const Chromosome& chrom1, const Chromosome& chrom2, const std::vector<int>& diceSequence);
+std::vector<Chromosome> recombine(const Chromosome& chrom1, const Chromosome& chrom2, const std::vector<int>& diceSequence, FitnessCache* cache = nullptr,
+                                  AssignFn assign = assignOptimally);
     // select recombination idx (consider position of leftmost 1 in both strings)
     // modify recombination idx: ensure that 5 genes are transferred
     // output offspring chromosomes
@@ -59,22 +122,87 @@ std::vector<Chromosome> recombine(const Chromosome& chrom1, const Chromosome& ch
     // offspring 2:
     // >06 from other|06|05|04|03|02|01
 
-Chromosome createChromosome(const std::vector<int>& diceSequence);
+Chromosome createChromosome(const std::vector<int>& diceSequence, AssignFn assign = assignOptimally);
 
-/* Defines an initial population of chromosomes*/
-std::vector<Chromosome> initializePopulation(const std::vector<int>& diceSequence, int popSize);
+/* Strategies for seeding the initial population with good solutions */
+enum class SeedStrategy {
+    GREEDY, // play without re-rolls and score the best remaining combination (as solveVeryGreedily)
+    WINDOW  // per round, choose the re-rolls that reach the window with the best remaining combination (as createScoreSheet)
+};
+
+/* Creates a chromosome by playing 'strategy'. With probability 'randomness' a round deviates
+ * from the strategy (GREEDY: skips a window, WINDOW: random re-rolls), so that seeds differ.
+ * The rounds of the strategies are looked up in the ScoreIndex of the dice sequence */
+Chromosome createSeededChromosome(const ScoreIndex& index, const std::vector<int>& diceSequence, SeedStrategy strategy, double randomness,
+                                  AssignFn assign = assignOptimally);
+
+/* Defines an initial population of chromosomes, a fraction of 'seedRatio' is created by seeding strategies */
+std::vector<Chromosome> initializePopulation(const std::vector<int>& diceSequence, int popSize, double seedRatio = 0.0, AssignFn assign = assignOptimally);
+
+/* Compact summary of a population at some generation */
+struct Telemetry {
+    int generationNbr;
+    int maxFitness;
+    double meanFitness;
+    double diversity; // mean pairwise hamming distance of the chromosomes relative to the chromosome length (0: all equal)
+};
+
+std::ostream& operator<<(std::ostream& os, const Telemetry& t);
 
 /* State of genetic algorithm */
 struct GState{
-    std::vector<Chromosome> population;
+    GState(std::vector<Chromosome> initialPopulation, int generationNbr = 0);
+    std::vector<Chromosome> population; // constant size, members are replaced in place
+    FitnessHeap leastFit; // min-heap of population indices to find the member to be replaced
+    int fittest; // index of the fittest member of the population
     int generationNbr;
+    int lastImprovement; // generation in which the max fitness has increased the last time
+    std::vector<Telemetry> telemetry; // collected every 'telemetryInterval' generations
+    std::unordered_map<uint64_t, int> memberHashes; // how many members have a chromosome with this hash
 };
 
 /* Params for genetic algorithm*/
 struct GParams {
     int populationSize = 50;    // initial population size
     double mutationProb = 0.01; // probability for each position in the chromosome that a mutation occurs in a generation
+    int tournamentSize = 2;     // number of random members competing for becoming a parent
+    double seedRatio = 0.1;     // fraction of the initial population created by greedy seeding strategies
+    // stopping criteria, 0 disables a criterion
+    int maxGenerations = 0;             // generation budget
+    double timeLimit = 0.0;             // wall clock budget in seconds
+    int stagnationWindow = 200000;      // stop if the max fitness has not increased for this many generations
+    int telemetryInterval = 10000;      // collect (and print) telemetry every N generations
+    std::string checkpointFile;         // if set: resume from this file if it exists and write checkpoints to it
+    int checkpointInterval = 1000000;   // write a checkpoint every N generations
+    FitnessCache* fitnessCache = nullptr; // optional cache of fitness values, may be shared by several populations
+    bool rejectDuplicates = false;        // whether chromosomes that are already in the population are rejected
+    bool exactAssignment = true;          // fitness by assignOptimally instead of assignGreedily (a cache must not mix both)
 };
 
+/* Assignment kernel selected by 'params' */
+AssignFn assignmentKernel(const GParams& params);
+
+/* Collects telemetry of the current population */
+Telemetry collectTelemetry(const GState& state);
+
+/* Whether any of the stopping criteria in 'params' is met, 'start' is the time at which the run started */
+bool shouldStop(const GState& state, const GParams& params, std::chrono::steady_clock::time_point start);
+
+/* Performs a single generation (recombination, mutation, selection) on the state */
+void evolve(GState& state, const std::vector<int>& diceSequence, const GParams& params);
+
+/* Seeds the random number engine used by the genetic algorithm on the calling thread */
+void seedGenetic(unsigned int seed);
+
+/* Returns copies of the 'n' fittest chromosomes, fittest first */
+std::vector<Chromosome> selectFittest(const GState& state, int n);
+
+/* Replaces the least fit member by 'c' if 'c' is at least as fit. Returns whether 'c' was added.
+ * With 'rejectDuplicates', 'c' is not added if the population already contains the same chromosome */
+bool replaceLeastFit(GState& state, const Chromosome& c, bool rejectDuplicates = false);
+
+/* Adds chromosomes from another population, replacing the least fit members */
+void immigrate(GState& state, const std::vector<Chromosome>& migrants, bool rejectDuplicates = false);
 
-void solveGenetic(const std::vector<int>& diceSequence, GParams params);
+/* Runs the genetic algorithm until a stopping criterion is met, returns the fittest chromosome */
+Chromosome solveGenetic(const std::vector<int>& diceSequence, GParams params);
@@ -0,0 +1,65 @@
+#include "Greedy.h"
+
+std::map<Combination, ScoreEntry> createScoreSheet(const ScoreIndex& index) {
+    std::map<Combination, ScoreEntry> scoreSheet;
+    for (int i = 0; i < index.nbrStarts(); ++i) {
+        for (int combiId = 1; combiId <= 11; ++combiId) {
+            Combination combi = static_cast<Combination>(combiId);
+            int score = index.windowScore(i, combiId);
+            if (score > scoreSheet[combi].score) {
+                scoreSheet[combi].score = score;
+                scoreSheet[combi].idx = std::make_pair(i, i + 5);
+            }
+        }
+    }
+    return scoreSheet;
+}
+
+GamePlan solveVeryGreedily(const ScoreIndex& index) {
+    GamePlan plan{0, {}};
+    int usedMask = 0; // bit (combiId-1) is set if the combination has been scored
+    for (int round = 0; round < 11; ++round) {
+        int start = 5 * round;
+        int bestCombi = 0;
+        int maxScore = 0;
+        for (int combiId = 1; combiId <= 11; ++combiId) {
+            if (!(usedMask & (1 << (combiId - 1))) && index.windowScore(start, combiId) >= maxScore) {
+                bestCombi = combiId;
+                maxScore = index.windowScore(start, combiId);
+            }
+        }
+        usedMask |= 1 << (bestCombi - 1);
+        plan.rounds[round] = {start, 0, 0, static_cast<Combination>(bestCombi), maxScore};
+        plan.score += maxScore;
+    }
+    return plan;
+}
+
+GamePlan solveGreedily(const ScoreIndex& index) {
+    GamePlan plan{0, {}};
+    int usedMask = 0;
+    int cursor = 0;
+    for (int round = 0; round < 11; ++round) {
+        int bestScore = -1, bestLength = 0, bestCombi = 0;
+        for (int length = 5; length <= MAX_ROUND_LENGTH && cursor + length <= index.sequenceLength(); ++length) {
+            for (int combiId = 1; combiId <= 11; ++combiId) {
+                if (usedMask & (1 << (combiId - 1))) continue;
+                int score = index.option(cursor, length, combiId).score;
+                bool better = score > bestScore
+                    || (score == bestScore && length == bestLength
+                        && index.bestFrom(cursor, combiId) < index.bestFrom(cursor, bestCombi));
+                if (better) {
+                    bestScore = score;
+                    bestLength = length;
+                    bestCombi = combiId;
+                }
+            }
+        }
+        const RoundOption& o = index.option(cursor, bestLength, bestCombi);
+        plan.rounds[round] = {cursor, o.firstReRoll, o.secondReRoll, static_cast<Combination>(bestCombi), o.score};
+        plan.score += o.score;
+        usedMask |= 1 << (bestCombi - 1);
+        cursor += bestLength;
+    }
+    return plan;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Common.h"
+#include "GameState.h"
+#include "ScoreIndex.h"
+
+#include <map>
+
+/* Greedy solvers: each round registers the best unused combination of the current round,
+ * without looking ahead. They are fast baselines for the other solvers.
+ */
+
+std::map<Combination, ScoreEntry> createScoreSheet(const ScoreIndex& index);
+    /// best 5-dice window [i, j) of the whole dice sequence for each combination
+
+GamePlan solveVeryGreedily(const ScoreIndex& index);
+    /// no re-rolls: round r uses the dice [5r, 5r+5)
+
+GamePlan solveGreedily(const ScoreIndex& index);
+    /// best re-roll window of each round, ties go to rounds using fewer dice,
+    /// then to the combination with the lower score in the remaining sequence
@@ -1,47 +1,134 @@
 #include "ILP.h"
+#include "BeamSearch.h"
+#include "ScoreIndex.h"
+
 #include <vector>
-#include "/usr/lib/lpsolve/lp_lib.h"
-
-ILPSolver::ILPSolver(std::vector<int> diceSequence) : m_diceSequence(diceSequence) {
-    // build ILP
-    // nbr of dice to be considered: 15 * 11 = 165
-    // for ones, twos, ..., 6s: we need 165 vars each
-    // chance: 165 vars
-    // sequence: 6 * 165 vars
-    // full house: 6 * 165 vars
-    // four of a kind: 6 * 165 vars
-    // five of a kind: 6 * 165 vars
-    // total: 7 * 165 + 4 * (6 * 165)
-    int nbrVars = 7 * 165 + 4 * (6 * 165);
-    lprec* ilp = make_lp(0, nbrVars);
-
-    // Variables are binary 
-    for(int i = 1; i <= nbrVars; ++i)
-    {
-        set_binary(ilp, i, TRUE);
-    }
-     
-    // add entries row by row
+#include <algorithm>
+#include <iostream>
+#include "lp_lib.h"
+
+namespace {
+
+constexpr int MAX_GAME_LENGTH = 11 * MAX_ROUND_LENGTH;
+
+/* Round y(p, l, c), variable 'column' in the ILP */
+struct Arc {
+    int start;
+    int length;
+    int combiId;
+};
+
+/// sparse row of a constraint (or the objective)
+struct SparseRow {
+    std::vector<int> colno;
+    std::vector<REAL> values;
+    void add(int column, REAL value) {
+        colno.push_back(column);
+        values.push_back(value);
+    }
+};
+
+bool addConstraint(lprec* ilp, SparseRow& row, int type, REAL rhs) {
+    if (!add_constraintex(ilp, row.colno.size(), row.values.data(), row.colno.data(), type, rhs)) {
+        std::cerr << "Adding constraint failed" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+ILPSolver::ILPSolver(const std::vector<int>& diceSequence) : m_diceSequence(diceSequence) {}
+
+ILPResult ILPSolver::solve(const ILPParams& params) const {
+    ScoreIndex index(m_diceSequence);
+    ILPResult result{GamePlan{-1, {}}, false};
+    if (params.warmStart) {
+        BeamParams beamParams;
+        beamParams.beamWidth = params.warmStartBeamWidth;
+        result.plan = solveBeam(index, beamParams);
+    }
+
+    // variables, column i+1 is arcs[i]
+    int lastEnd = std::min(index.sequenceLength(), MAX_GAME_LENGTH);
+    std::vector<Arc> arcs;
+    std::vector<SparseRow> out(lastEnd + 1), in(lastEnd + 1), combinations(12);
+    SparseRow objective;
+    for (int start = 0; start <= lastEnd - 5; start = (start == 0 ? 5 : start + 1)) {
+        for (int length = 5; length <= MAX_ROUND_LENGTH && start + length <= lastEnd; ++length) {
+            for (int combiId = 1; combiId <= 11; ++combiId) {
+                arcs.push_back({start, length, combiId});
+                int column = arcs.size();
+                int score = index.option(start, length, combiId).score;
+                out[start].add(column, 1.0);
+                in[start + length].add(column, -1.0);
+                combinations[combiId].add(column, 1.0);
+                if (score > 0) {
+                    objective.add(column, score);
+                }
+            }
+        }
+    }
+
+    lprec* ilp = make_lp(0, arcs.size());
+    if (ilp == nullptr) {
+        std::cerr << "Creating the ILP failed" << std::endl;
+        return result;
+    }
+    for (int column = 1; column <= static_cast<int>(arcs.size()); ++column) {
+        set_binary(ilp, column, TRUE);
+    }
     set_add_rowmode(ilp, TRUE);
-    
-    // indices of the variables
-    std::vector<int> colno(nbrVars);
-
-    // coefficients of the variables
-    std::vector<REAL> row(nbrVars, 1.0);
-
-    int c = 9;
-    for(int j = 1; j <= 8; ++j)
-    {
-        for(int i = 0; i < 8; ++i, ++c)
-        {
-            colno[i] = c;
+    set_obj_fnex(ilp, objective.colno.size(), objective.values.data(), objective.colno.data());
+    set_maxim(ilp);
+    bool ok = addConstraint(ilp, out[0], EQ, 1.0);
+    for (int q = 5; ok && q <= lastEnd; ++q) {
+        if (out[q].colno.empty()) continue;
+        SparseRow flow = out[q];
+        flow.colno.insert(flow.colno.end(), in[q].colno.begin(), in[q].colno.end());
+        flow.values.insert(flow.values.end(), in[q].values.begin(), in[q].values.end());
+        ok = addConstraint(ilp, flow, LE, 0.0);
+    }
+    for (int combiId = 1; ok && combiId <= 11; ++combiId) {
+        ok = addConstraint(ilp, combinations[combiId], EQ, 1.0);
+    }
+    if (ok && result.plan.score > 0) {
+        ok = addConstraint(ilp, objective, GE, result.plan.score);
+    }
+    set_add_rowmode(ilp, FALSE);
+    if (!ok) {
+        delete_lp(ilp);
+        return result;
+    }
+
+    set_verbose(ilp, IMPORTANT);
+    if (params.timeLimit > 0) {
+        set_timeout(ilp, std::max(1L, static_cast<long>(params.timeLimit)));
+    }
+    int ret = ::solve(ilp);
+    if (ret == OPTIMAL || ret == SUBOPTIMAL) {
+        std::vector<REAL> values(arcs.size());
+        get_variables(ilp, values.data());
+        std::vector<Arc> rounds;
+        for (int i = 0; i < static_cast<int>(arcs.size()); ++i) {
+            if (values[i] > 0.5) {
+                rounds.push_back(arcs[i]);
+            }
+        }
+        std::sort(rounds.begin(), rounds.end(), [](const Arc& a, const Arc& b) { return a.start < b.start; });
+        GamePlan plan{0, {}};
+        for (int r = 0; r < static_cast<int>(rounds.size()) && r < 11; ++r) {
+            const RoundOption& o = index.option(rounds[r].start, rounds[r].length, rounds[r].combiId);
+            plan.rounds[r] = {rounds[r].start, o.firstReRoll, o.secondReRoll, static_cast<Combination>(rounds[r].combiId), o.score};
+            plan.score += o.score;
         }
-        if (!add_constraintex(ilp, 8, &row[0], &colno[0], EQ, 1.))
-        {
-            cerr << "Adding constraint failed" << endl;
-            return false;
+        if (rounds.size() == 11 && plan.score >= result.plan.score) {
+            result.plan = plan;
         }
+        result.isOptimal = ret == OPTIMAL;
+    } else if (ret != TIMEOUT) {
+        std::cerr << "ILP solver failed: " << ret << std::endl;
     }
+    delete_lp(ilp);
+    return result;
 }
-
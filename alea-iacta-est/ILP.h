@@ -1,50 +1,42 @@
+#pragma once
+
+#include "GameState.h"
+
 #include <vector>
 
-/* ILP solver for Yahtzee*/
+/* ILP solver for Yahtzee */
 
-/* Repetition of individual numbers:
- * 1s, 2s, 3s, 4s, 5s, 6s: 15 * 11 bits
- * constraint: use only 1s, 2s, ... etc
- * scoring function: sum of selected dice
- *
- * Chance: 
- * 15 * 11 bits
- * no special constraints
- * scoring function: sum
- *
- * All others: bit vectors for 1s, ... up to 6s with 15 * 11 bits each
- * idea: need to count the selected type of elements
- *
- * Sequence:
- * constraint is that no element is duplicated
- * and that the difference between sorted values is at most 1
- * simpler: only 1,2,3,4,5=15 or 2,3,4,5,6=20 is allowed and there is no duplication
+/* A round is an arc p -> p+l over the positions of the dice sequence:
+ * binary variable y(p, l, c) = 1 if a round uses the dice [p, p+l) and registers combination c.
+ * Its objective coefficient is the best score of such a round (best re-roll masks, see ScoreIndex).
  *
- * Full House:
- * two in some number seq selected, three in another number seq
+ * Rounds form a path that starts at dice 0:
+ *   sum_out(0) = 1
+ *   sum_out(q) - sum_in(q) <= 0           for q > 0 (no round starts where no round ended)
+ * Each combination is registered exactly once (so the path has 11 rounds):
+ *   sum_{p,l} y(p, l, c) = 1              for c = ONES .. CHANCE
+ * Incumbent (best heuristic score h, prunes the branch & bound tree):
+ *   sum score(p, l, c) * y(p, l, c) >= h
  *
- * Four of a kind:
- * exact four in one number seq
- *
- * Five of a kind
- * exactly five in one number seq
- *
-// enum class Combination {
-    ONES = 1, 
-    TWOS,
-    THREES,
-    FOURS,
-    FIVES,
-    SIXES,
-    SEQUENCE,
-    FULL_HOUSE,
-    FOUR_OF_A_KIND,
-    FIVE_OF_A_KIND,
-    CHANCE
+ * Rounds can only start at 0 or 5..150 and end at or before 165, only the non-zero entries
+ * of the constraints are passed to lp_solve.
+ */
+
+struct ILPParams {
+    double timeLimit = 60.0;        // seconds, 0: no limit
+    bool warmStart = true;          // use a beam search solution as incumbent
+    int warmStartBeamWidth = 1000;
+};
+
+struct ILPResult {
+    GamePlan plan;
+    bool isOptimal;     // false: time limit reached (or solver failure), plan is the best one found
 };
-*/
 
-struct ILPSolver {
-    ILPSolver(std::vector<int> diceSequence);
+class ILPSolver {
+public:
+    ILPSolver(const std::vector<int>& diceSequence);
+    ILPResult solve(const ILPParams& params) const;
+private:
     std::vector<int> m_diceSequence;
 };
@@ -0,0 +1,77 @@
+#include "Islands.h"
+#include "Genetic.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace {
+
+/// mailbox for migrants on one edge of the ring, written by one island and read by the next one
+struct MigrationChannel {
+    std::vector<Chromosome> migrants;
+    std::atomic<bool> full{false}; // true while migrants have been sent, but not yet received
+};
+
+/// sends migrants unless the neighbour has not picked up the previous ones yet
+void sendMigrants(MigrationChannel& channel, const GState& state, int migrationSize) {
+    if (channel.full.load(std::memory_order_acquire)) {
+        return; // neighbour is busy, skip this migration
+    }
+    channel.migrants = selectFittest(state, migrationSize);
+    channel.full.store(true, std::memory_order_release);
+}
+
+/// integrates migrants into the population, if there are any
+void receiveMigrants(MigrationChannel& channel, GState& state, bool rejectDuplicates) {
+    if (!channel.full.load(std::memory_order_acquire)) {
+        return;
+    }
+    immigrate(state, channel.migrants, rejectDuplicates);
+    channel.full.store(false, std::memory_order_release);
+}
+
+void evolveIsland(int island, const std::vector<int>& diceSequence, const GParams& params,
+                  const IslandParams& islandParams, std::vector<std::unique_ptr<MigrationChannel>>& channels,
+                  std::chrono::steady_clock::time_point start, Chromosome& fittest) {
+    seedGenetic(island + 1);
+    int nbrIslands = islandParams.nbrIslands;
+    MigrationChannel& outbox = *channels[island];
+    MigrationChannel& inbox = *channels[(island + nbrIslands - 1) % nbrIslands];
+    GState state{initializePopulation(diceSequence, params.populationSize, params.seedRatio, assignmentKernel(params)), 0};
+    while (!shouldStop(state, params, start)) {
+        evolve(state, diceSequence, params);
+        if (nbrIslands > 1) {
+            if (state.generationNbr % islandParams.migrationInterval == 0) {
+                sendMigrants(outbox, state, islandParams.migrationSize);
+            }
+            receiveMigrants(inbox, state, params.rejectDuplicates);
+        }
+    }
+    fittest = state.population[state.fittest];
+}
+}
+
+Chromosome solveIslands(const std::vector<int>& diceSequence, const GParams& params, const IslandParams& islandParams) {
+    int nbrIslands = islandParams.nbrIslands;
+    std::vector<std::unique_ptr<MigrationChannel>> channels; // channel i: from island i to island i+1
+    for (int i = 0; i < nbrIslands; ++i) {
+        channels.emplace_back(new MigrationChannel);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Chromosome> fittest(nbrIslands);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nbrIslands; ++i) {
+        threads.emplace_back(evolveIsland, i, std::cref(diceSequence), std::cref(params), std::cref(islandParams),
+                             std::ref(channels), start, std::ref(fittest[i]));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return *std::max_element(fittest.begin(), fittest.end(), [](const Chromosome& c1, const Chromosome& c2) {
+        return c1.fitness < c2.fitness;
+    });
+}
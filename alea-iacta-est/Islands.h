@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Genetic.h"
+
+#include <vector>
+
+/* Island model for the genetic algorithm:
+ * several populations (islands) evolve independently on their own threads.
+ * Every 'migrationInterval' generations, each island sends copies of its fittest
+ * chromosomes to the next island in a ring (0 -> 1 -> ... -> n-1 -> 0).
+ * Migration is lock-free: each edge of the ring is a single-producer single-consumer mailbox.
+ * Each island stops when the stopping criteria of the GParams are met.
+ */
+
+/* Params for the island model */
+struct IslandParams {
+    int nbrIslands = 4;             // number of populations, each one evolves on its own thread
+    int migrationInterval = 1000;   // number of generations between two migrations of an island
+    int migrationSize = 2;          // number of fittest chromosomes that migrate to the next island
+};
+
+/* Evolves 'nbrIslands' populations in parallel and returns the fittest chromosome of all islands */
+Chromosome solveIslands(const std::vector<int>& diceSequence, const GParams& params, const IslandParams& islandParams);
@@ -0,0 +1,43 @@
+#include "RNG.h"
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+RNG::RNG(const Scenario& s) :  m_s(s), m_X(m_s.X) {
+}
+
+int RNG::rollDice() {
+    // update random sequence X
+    // modulo: only select the lower 32 bits
+    m_X = (m_s.A * m_X + m_s.C) % static_cast<int64_t>(pow(2, 32));
+    // randomness is only in higher bits -> discard the 16 lower bits
+    int roll = (static_cast<int>(m_X / pow(2, 16))) % 6 + 1;
+    return roll;
+}
+
+std::vector<int> determineDiceSequence(RNG& rng) {
+    // determine sequence for longest possible game
+    // 11 rounds with 6 dice. It's possible to re-roll 2 times
+    // -> 11 * (6 * 3) rolls at most
+    int maxNbrRolls = 11 * (6 * 3);
+    std::vector<int> seq;
+    seq.reserve(maxNbrRolls);
+    while (maxNbrRolls--) {
+        int roll = rng.rollDice();
+        // output of RNG:
+        // std::cout << "Roll: " << roll << std::endl;
+        seq.push_back(roll);
+    }
+    return seq;
+}
+
+int sequencePeriod(const std::vector<int>& diceSequence) {
+    int n = diceSequence.size();
+    for (int p = 1; p < n; ++p) {
+        if (std::equal(diceSequence.begin() + p, diceSequence.end(), diceSequence.begin())) {
+            return p;
+        }
+    }
+    return n;
+}
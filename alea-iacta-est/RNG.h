@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// A game scenario defined by the initial random number generator state
+struct Scenario {
+    int A; // multiplier
+    int C; // increment
+    int64_t X; // initial seed
+};
+
+/// A linear congruential random number generator
+class RNG {
+public:
+    RNG(const Scenario& s);
+    int rollDice();
+    
+private:
+    Scenario m_s;
+    int64_t m_X; // current random number
+};
+
+/// determine sequence of dice from RNG
+std::vector<int> determineDiceSequence(RNG& rng);
+
+/// smallest p with seq[i] == seq[i+p] for all i, the length of the sequence if it is not periodic
+/// (degenerate LCG parameters give short periods)
+int sequencePeriod(const std::vector<int>& diceSequence);
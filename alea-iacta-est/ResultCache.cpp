@@ -0,0 +1,104 @@
+#include "ResultCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+DiceFingerprint fingerprintDiceSequence(const std::vector<int>& diceSequence) {
+    DiceFingerprint f;
+    int n = std::min<int>(diceSequence.size(), DiceFingerprint::NBR_DICE);
+    for (int i = 0; i < n; ++i) {
+        int bit = 3 * i;
+        uint64_t value = diceSequence[i]; // 1..6, 0 marks the end of a shorter sequence
+        f.packed[bit / 64] |= value << (bit % 64);
+        if (bit % 64 > 61) {
+            f.packed[bit / 64 + 1] |= value >> (64 - bit % 64);
+        }
+    }
+    return f;
+}
+
+size_t DiceFingerprintHash::operator()(const DiceFingerprint& f) const {
+    uint64_t h = 0;
+    for (uint64_t word : f.packed) {
+        // splitmix64 finalizer
+        uint64_t z = h ^ (word + 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        h = z ^ (z >> 31);
+    }
+    return h;
+}
+
+namespace {
+
+std::string toLine(const std::vector<int>& diceSequence, const GamePlan& plan) {
+    std::ostringstream os;
+    int n = std::min<int>(diceSequence.size(), DiceFingerprint::NBR_DICE);
+    for (int i = 0; i < n; ++i) {
+        os << diceSequence[i];
+    }
+    os << " " << plan.score;
+    for (const PlannedRound& r : plan.rounds) {
+        os << " " << r.start << " " << static_cast<int>(r.firstReRoll) << " " << static_cast<int>(r.secondReRoll)
+           << " " << static_cast<int>(r.combination) << " " << r.score;
+    }
+    return os.str();
+}
+
+bool fromLine(const std::string& line, std::vector<int>& diceSequence, GamePlan& plan) {
+    std::istringstream is(line);
+    std::string dice;
+    if (!(is >> dice >> plan.score)) return false;
+    diceSequence.clear();
+    for (char c : dice) {
+        if (c < '1' || c > '6') return false;
+        diceSequence.push_back(c - '0');
+    }
+    for (PlannedRound& r : plan.rounds) {
+        int m1, m2, combiId;
+        if (!(is >> r.start >> m1 >> m2 >> combiId >> r.score) || combiId < 1 || combiId > 11) return false;
+        r.firstReRoll = m1;
+        r.secondReRoll = m2;
+        r.combination = static_cast<Combination>(combiId);
+    }
+    return true;
+}
+
+} // namespace
+
+ResultCache::ResultCache(const std::string& fileName) : m_fileName(fileName) {
+    if (m_fileName.empty()) return;
+    std::ifstream is(m_fileName);
+    std::string line;
+    std::vector<int> diceSequence;
+    GamePlan plan;
+    int lineNbr = 0;
+    while (std::getline(is, line)) {
+        ++lineNbr;
+        if (fromLine(line, diceSequence, plan)) {
+            m_plans[fingerprintDiceSequence(diceSequence)] = plan;
+        } else {
+            std::cerr << "Ignoring invalid line " << lineNbr << " of result cache " << m_fileName << std::endl;
+        }
+    }
+}
+
+std::optional<GamePlan> ResultCache::lookup(const std::vector<int>& diceSequence) {
+    auto it = m_plans.find(fingerprintDiceSequence(diceSequence));
+    if (it == m_plans.end()) {
+        ++m_misses;
+        return std::nullopt;
+    }
+    ++m_hits;
+    return it->second;
+}
+
+void ResultCache::insert(const std::vector<int>& diceSequence, const GamePlan& plan) {
+    bool isNew = m_plans.insert_or_assign(fingerprintDiceSequence(diceSequence), plan).second;
+    if (isNew && !m_fileName.empty()) {
+        std::ofstream os(m_fileName, std::ios::app);
+        os << toLine(diceSequence, plan) << "\n";
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "GameState.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Dice that a game can use: at most 11 rounds of 5 dice and two re-rolls of all dice.
+ * Scenarios with the same fingerprint have the same solutions, whatever their (A, C, X) are.
+ * 3 bits per dice, exact (no hash collisions).
+ */
+struct DiceFingerprint {
+    static constexpr int NBR_DICE = 11 * 15;
+    std::array<uint64_t, (3 * NBR_DICE + 63) / 64> packed{};
+    bool operator==(const DiceFingerprint& other) const { return packed == other.packed; }
+};
+
+DiceFingerprint fingerprintDiceSequence(const std::vector<int>& diceSequence);
+
+struct DiceFingerprintHash {
+    size_t operator()(const DiceFingerprint& f) const;
+};
+
+/* Solutions of already solved dice sequences, optionally persisted in a text file.
+ * A cache holds the results of one solver configuration (e.g. exact solutions only).
+ * File format, one line per entry: the dice of the fingerprint as digits, the score,
+ * and per round: start first-re-roll second-re-roll combination-id score
+ */
+class ResultCache {
+public:
+    ResultCache(const std::string& fileName = "");
+        /// loads the entries of 'fileName' if it exists, new entries are appended to it
+    std::optional<GamePlan> lookup(const std::vector<int>& diceSequence);
+    void insert(const std::vector<int>& diceSequence, const GamePlan& plan);
+    int hits() const { return m_hits; }
+    int misses() const { return m_misses; }
+    int size() const { return m_plans.size(); }
+private:
+    std::string m_fileName;
+    std::unordered_map<DiceFingerprint, GamePlan, DiceFingerprintHash> m_plans;
+    int m_hits = 0;
+    int m_misses = 0;
+};
@@ -55,7 +55,7 @@ void Roll::roll() {
     //printRoll(m_diceValues);
 }
 
-void Roll::reRoll(std::vector<int> reRollIdx) {
+void Roll::reRoll(const std::vector<int>& reRollIdx) {
     // TODO: for reRoll it is not 100% clear whether the reRoll idx can be assumed to be evaluated in
     // the order of the input or in the order of the indices by the user
     assert(m_remainingReRolls > 0 && "At most two re-rolls allowed");
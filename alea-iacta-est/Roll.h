@@ -27,7 +27,7 @@ struct Roll {
     }
 
     void roll(); /// performs a roll of five dice: updates m_diceValues and m_rolledDiceCount
-    void reRoll(std::vector<int> reRollIdx); /// re-rolls the dice at the specified indices
+    void reRoll(const std::vector<int>& reRollIdx); /// re-rolls the dice at the specified indices
     std::vector<int> registerRoll(Combination combi); /// registers the roll with the judge, returns the roll
 
     std::vector<int> m_diceValues; /// dice values of current five-dice roll
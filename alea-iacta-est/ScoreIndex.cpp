@@ -0,0 +1,76 @@
+#include "ScoreIndex.h"
+#include "BatchScorer.h"
+#include "RNG.h"
+
+#include <algorithm>
+#include <array>
+
+ScoreIndex::ScoreIndex(const std::vector<int>& diceSequence)
+        : m_sequenceLength(diceSequence.size()), m_nbrStarts(std::max(0, m_sequenceLength - 5 + 1)),
+          m_options(m_nbrStarts * NBR_LENGTHS * 11, RoundOption{0, 0, 0, false}), m_bestFrom((m_nbrStarts + 1) * 11, 0) {
+    // all rolls of a start, scored as one batch: roll k uses the re-roll masks (masks[k] >> 5, masks[k] & 31)
+    constexpr int NBR_ROLLS = 32 * 32;
+    std::vector<uint8_t> dice(5 * NBR_ROLLS), scores(11 * NBR_ROLLS);
+    std::array<uint16_t, NBR_ROLLS> masks;
+    const uint8_t* diceRows[5];
+    uint8_t* scoreRows[11];
+    for (int i = 0; i < 5; ++i) diceRows[i] = &dice[i * NBR_ROLLS];
+    for (int c = 0; c < 11; ++c) scoreRows[c] = &scores[c * NBR_ROLLS];
+    // rounds of periodic sequences repeat: copy them unless they are cut off by the end of the sequence
+    int period = sequencePeriod(diceSequence);
+    const int rowSize = NBR_LENGTHS * 11;
+    for (int start = 0; start < m_nbrStarts; ++start) {
+        if (start >= period && start + MAX_ROUND_LENGTH <= m_sequenceLength) {
+            std::copy_n(&m_options[(start - period) * rowSize], rowSize, &m_options[start * rowSize]);
+            continue;
+        }
+        int nbrRolls = 0;
+        for (int m1 = 0; m1 < 32; ++m1) {
+            for (int m2 = 0; m2 < 32; ++m2) {
+                int length = 5 + __builtin_popcount(m1) + __builtin_popcount(m2);
+                if (start + length > m_sequenceLength) continue;
+                int cursor = start + 5;
+                for (int i = 0; i < 5; ++i) {
+                    int value = diceSequence[start + i];
+                    if (m1 & (1 << i)) value = diceSequence[cursor++];
+                    dice[i * NBR_ROLLS + nbrRolls] = value;
+                }
+                for (int i = 0; i < 5; ++i) {
+                    if (m2 & (1 << i)) dice[i * NBR_ROLLS + nbrRolls] = diceSequence[cursor++];
+                }
+                masks[nbrRolls++] = m1 << 5 | m2;
+            }
+        }
+        scoreBatch(diceRows, nbrRolls, scoreRows);
+        for (int k = 0; k < nbrRolls; ++k) {
+            int m1 = masks[k] >> 5, m2 = masks[k] & 31;
+            int length = 5 + __builtin_popcount(m1) + __builtin_popcount(m2);
+            RoundOption* o = &m_options[(start * NBR_LENGTHS + length - 5) * 11];
+            for (int c = 0; c < 11; ++c) {
+                uint8_t score = scoreRows[c][k];
+                if (!o[c].valid || score > o[c].score) {
+                    o[c] = {score, static_cast<uint8_t>(m1), static_cast<uint8_t>(m2), true};
+                }
+            }
+        }
+    }
+    for (int start = m_nbrStarts - 1; start >= 0; --start) {
+        for (int combiId = 1; combiId <= 11; ++combiId) {
+            int best = m_bestFrom[(start + 1) * 11 + combiId - 1];
+            for (int length = 5; length <= MAX_ROUND_LENGTH; ++length) {
+                best = std::max(best, static_cast<int>(option(start, length, combiId).score));
+            }
+            m_bestFrom[start * 11 + combiId - 1] = best;
+        }
+    }
+}
+
+int ScoreIndex::bound(int cursor, int usedMask) const {
+    int b = 0;
+    for (int combiId = 1; combiId <= 11; ++combiId) {
+        if (!(usedMask & (1 << (combiId - 1)))) {
+            b += bestFrom(std::min(cursor, m_nbrStarts), combiId);
+        }
+    }
+    return b;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Common.h"
+
+#include <cstdint>
+#include <vector>
+
+/* Scores of a dice sequence, computed once per scenario and shared by the solvers.
+ * A round starting at dice 'start' with re-roll masks m1, m2 uses the dice [start, start+length)
+ * with length = 5 + popcount(m1) + popcount(m2). For every start, length (5..15) and combination
+ * the index stores the best score over all re-roll masks of that length, and the masks reaching it.
+ * Length 5 are the plain 5-dice windows.
+ * All entries are in flat arrays: [start][length-5][combiId-1] and [start][combiId-1].
+ */
+
+constexpr int MAX_ROUND_LENGTH = 15;    // 5 dice + two re-rolls of all dice
+
+/* Best re-roll masks of a round for a given start, length and combination */
+struct RoundOption {
+    uint8_t score;
+    uint8_t firstReRoll;
+    uint8_t secondReRoll;
+    bool valid;     // masks were found (a score of 0 is still a valid round)
+};
+
+class ScoreIndex {
+public:
+    ScoreIndex(const std::vector<int>& diceSequence);
+    const RoundOption& option(int start, int length, int combiId) const {
+        return m_options[(start * NBR_LENGTHS + length - 5) * 11 + combiId - 1];
+    }
+    int windowScore(int start, int combiId) const { return option(start, 5, combiId).score; }
+        /// score of the 5-dice window [start, start+5) without re-rolls
+    int bestFrom(int start, int combiId) const { return m_bestFrom[start * 11 + combiId - 1]; }
+        /// upper bound on the score of 'combiId' for rounds starting at 'start' or later
+    int bound(int cursor, int usedMask) const;
+        /// upper bound on the score of all unused combinations
+    int nbrStarts() const { return m_nbrStarts; }
+    int sequenceLength() const { return m_sequenceLength; }
+private:
+    static constexpr int NBR_LENGTHS = MAX_ROUND_LENGTH - 5 + 1;
+    int m_sequenceLength;
+    int m_nbrStarts;
+    std::vector<RoundOption> m_options;
+    std::vector<int> m_bestFrom;
+};
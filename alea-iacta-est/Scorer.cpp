@@ -1,120 +1,81 @@
 #include "Scorer.h"
 
-#include <unordered_map>
-#include <numeric>
 #include <iostream>
 #include <cassert>
-#include <algorithm>
 
-int scoreRepetition(const std::vector<int>& rolls, int repeatedValue) {
-    int score = 0;
-    for (const auto& roll : rolls) {
-        if (roll == repeatedValue) {
-            score += repeatedValue;
-        }
-    }
-    return score;
-}
+namespace {
 
-int scoreSequence(const std::vector<int>& rolls) {
-    int score = 0;
-    std::vector<int> orderedVec(rolls.begin(), rolls.end());
-    std::sort(orderedVec.begin(), orderedVec.end());
-    for (int i = 0; i < orderedVec.size(); ++i) {
-        if (i != orderedVec.size() - 1) {
-            if (orderedVec[i+1] - orderedVec[i] != 1) {
-                // not a sequence
-                score = 0;
-                break;
-            }
-        } 
-        score += orderedVec[i];
-    }
-    return score;
-}
+/* Number of dice per value (index 1..6) and sum of a five-dice roll */
+struct Histogram {
+    std::array<uint8_t, 7> counts{};
+    int sum = 0;
+};
 
-int scoreFullHouse(const std::vector<int>& rolls) {
-    // need to ensure that one value is repeated 3 times, the other one two times
-    std::unordered_map<int, int> rollCounts; // how often each number was rolled
-    for (int roll : rolls) {
-        rollCounts[roll] += 1;
-    }
-    if (rollCounts.size() != 2) {
-        // no full house possible
-        return 0;
-    }
-    // check full house
-    int score = 0;
-    for (auto it = rollCounts.begin(); it != rollCounts.end(); ++it) {
-        if (it->second == 3 || it->second == 2) {
-            score += it->first*it->second;
-        } else {
-            score = 0;
-            break;
-        }
-    }
-    return score;
-}
-
-int scoreChance(const std::vector<int>& rolls) {
-    return std::accumulate(rolls.begin(), rolls.end(), 0);
-}
-int scoreMultipleOfAKind(const std::vector<int>& rolls, int N) {
-    assert(N >= 4 && "Need N >= 4 for scoreMultipleOfAKind");
-
-    std::unordered_map<int, int> rollCounts; // how often each number was rolled
-    for (int roll : rolls) {
-        rollCounts[roll] += 1;
-    }
-    // check 'N' of a kind
-    bool foundN = false;
-    int score = 0;
-    for (auto it = rollCounts.begin(); it != rollCounts.end(); ++it) {
-        if (it->second == N) {
-            foundN = true;
-        }
-        score += it->first*it->second;
-    }
-    if (foundN && N == 5) {
-        return 50; // special rule
-    } else if (foundN) {
-        return score; // sum of values
-    } else {
-        return 0; // condition not fulfilled
+template <typename It>
+Histogram makeHistogram(It first, It last) {
+    Histogram h;
+    for (; first != last; ++first) {
+        assert(*first >= 1 && *first <= 6 && "Invalid dice value!");
+        h.counts[*first] += 1;
+        h.sum += *first;
     }
+    return h;
 }
 
-int scoreRoll(const std::vector<int>& rolls, Combination combi) {
-    assert(rolls.size() == 5 && "Must use 5 dice per roll!");
-
-    //std::cout << "scoreRoll() for: " << combi << std::endl;
-    //printRoll(rolls);
+int scoreHistogram(const Histogram& h, Combination combi) {
     switch (combi) {
         case Combination::ONES:
         case Combination::TWOS:
         case Combination::THREES:
         case Combination::FOURS:
         case Combination::FIVES:
-        case Combination::SIXES:
-            return scoreRepetition(rolls, static_cast<int>(combi));
-        case Combination::SEQUENCE:
-            return scoreSequence(rolls);
-        case Combination::FULL_HOUSE:
-            return scoreFullHouse(rolls);
+        case Combination::SIXES: {
+            int value = static_cast<int>(combi);
+            return h.counts[value] * value;
+        }
+        case Combination::SEQUENCE: {
+            // five distinct consecutive values: 1..5 or 2..6
+            bool inner = h.counts[2] == 1 && h.counts[3] == 1 && h.counts[4] == 1 && h.counts[5] == 1;
+            return (inner && (h.counts[1] == 1 || h.counts[6] == 1)) ? h.sum : 0;
+        }
+        case Combination::FULL_HOUSE: {
+            // exactly two values, one repeated three times, the other one two times
+            bool three = false, two = false;
+            for (int v = 1; v <= 6; ++v) {
+                three |= h.counts[v] == 3;
+                two |= h.counts[v] == 2;
+            }
+            return (three && two) ? h.sum : 0;
+        }
         case Combination::FOUR_OF_A_KIND:
-            return scoreMultipleOfAKind(rolls, 4);
-        case Combination::FIVE_OF_A_KIND:
-            return scoreMultipleOfAKind(rolls, 5);
+        case Combination::FIVE_OF_A_KIND: {
+            int N = combi == Combination::FOUR_OF_A_KIND ? 4 : 5;
+            for (int v = 1; v <= 6; ++v) {
+                if (h.counts[v] == N) {
+                    return N == 5 ? FIVE_OF_A_KIND_SCORE : h.sum;
+                }
+            }
+            return 0;
+        }
         case Combination::CHANCE:
-            return scoreChance(rolls);
+            return h.sum;
         default:
-            std::abort(); 
+            std::abort();
     }
 }
 
-int scoreRollInSeq(const std::vector<int>& diceValues, Combination combi, int start, int end) {
-    std::vector<int> subSeq = std::vector<int>(diceValues.begin() + start, diceValues.begin() + end); // TODO: this is not very fast (vector copy is unnecessary if we work on contiguous dice data)
-    return scoreRoll(subSeq, combi);
+} // namespace
+
+int scoreRoll(const std::array<uint8_t, 5>& dice, Combination combi) {
+    return scoreHistogram(makeHistogram(dice.begin(), dice.end()), combi);
 }
 
+int scoreRoll(const std::vector<int>& rolls, Combination combi) {
+    assert(rolls.size() == 5 && "Must use 5 dice per roll!");
+    return scoreHistogram(makeHistogram(rolls.begin(), rolls.end()), combi);
+}
 
+int scoreRollInSeq(const std::vector<int>& diceValues, Combination combi, int start, int end) {
+    assert(end - start == 5 && "Must use 5 dice per roll!");
+    return scoreHistogram(makeHistogram(diceValues.begin() + start, diceValues.begin() + end), combi);
+}
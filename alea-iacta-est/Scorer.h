@@ -1,7 +1,9 @@
-#pragma <once>
+#pragma once
 
 #include "Common.h"
 
+#include <array>
+#include <cstdint>
 #include <vector>
 
 /*
@@ -11,7 +13,12 @@ int scoreFullHouse(const std::vector<int>& rolls);
 int scoreChance(const std::vector<int>& rolls);
 int scoreMultipleOfAKind(const std::vector<int>& rolls, int N);
 */
+constexpr int FIVE_OF_A_KIND_SCORE = 50; // special rule for five of a kind
+constexpr int MAX_ROLL_SCORE = FIVE_OF_A_KIND_SCORE; // the other combinations score at most the sum of the dice (30)
+
 int scoreRoll(const std::vector<int>& rolls, Combination combi);
+/// allocation-free scorer on a histogram of the dice, the vector version delegates to it
+int scoreRoll(const std::array<uint8_t, 5>& dice, Combination combi);
 
 
 
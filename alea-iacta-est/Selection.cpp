@@ -0,0 +1,76 @@
+#include "Selection.h"
+#include "Genetic.h"
+
+#include <vector>
+
+void FitnessHeap::place(int i, const Entry& e) {
+    m_heap[i] = e;
+    m_pos[e.slot] = i;
+}
+
+void FitnessHeap::siftUp(int i) {
+    Entry e = m_heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (m_heap[parent].fitness <= e.fitness) {
+            break;
+        }
+        place(i, m_heap[parent]);
+        i = parent;
+    }
+    place(i, e);
+}
+
+void FitnessHeap::siftDown(int i) {
+    Entry e = m_heap[i];
+    int n = m_heap.size();
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= n) {
+            break;
+        }
+        if (child + 1 < n && m_heap[child + 1].fitness < m_heap[child].fitness) {
+            child += 1;
+        }
+        if (e.fitness <= m_heap[child].fitness) {
+            break;
+        }
+        place(i, m_heap[child]);
+        i = child;
+    }
+    place(i, e);
+}
+
+void FitnessHeap::build(const std::vector<Chromosome>& population) {
+    int n = population.size();
+    m_heap.resize(n);
+    m_pos.resize(n);
+    for (int slot = 0; slot < n; ++slot) {
+        place(slot, {population[slot].fitness, slot});
+    }
+    for (int i = n / 2 - 1; i >= 0; --i) {
+        siftDown(i);
+    }
+}
+
+void FitnessHeap::update(int slot, int fitness) {
+    int i = m_pos[slot];
+    int oldFitness = m_heap[i].fitness;
+    m_heap[i].fitness = fitness;
+    if (fitness < oldFitness) {
+        siftUp(i);
+    } else {
+        siftDown(i);
+    }
+}
+
+int selectByTournament(const std::vector<Chromosome>& population, int tournamentSize, std::minstd_rand& engine) {
+    int best = engine() % population.size();
+    for (int i = 1; i < tournamentSize; ++i) {
+        int candidate = engine() % population.size();
+        if (population[candidate].fitness > population[best].fitness) {
+            best = candidate;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <random>
+
+struct Chromosome;
+
+/* Indexed min-heap over the slots of a population, keyed by fitness.
+ * The least fit chromosome is on top. Chromosomes are referenced by their
+ * index in the population, so that replacing a member costs O(log P) and no copies.
+ */
+class FitnessHeap {
+public:
+    void build(const std::vector<Chromosome>& population);
+        /// (re-)builds the heap for all members of the population
+    int leastFit() const { return m_heap[0].slot; }
+        /// index of the least fit chromosome in the population
+    int minFitness() const { return m_heap[0].fitness; }
+        /// fitness of the least fit chromosome
+    void update(int slot, int fitness);
+        /// restores the heap after the chromosome at 'slot' has changed its fitness
+private:
+    struct Entry {
+        int fitness;
+        int slot; // index in the population
+    };
+    std::vector<Entry> m_heap;
+    std::vector<int> m_pos; // position of each population slot in 'm_heap'
+    void siftUp(int i);
+    void siftDown(int i);
+    void place(int i, const Entry& e);
+};
+
+/* Tournament selection: draws 'tournamentSize' random members and returns the index of the fittest one */
+int selectByTournament(const std::vector<Chromosome>& population, int tournamentSize, std::minstd_rand& engine);
@@ -0,0 +1,85 @@
+#include "ClosedForm.h"
+
+#include <cassert>
+
+namespace {
+
+/// moves of the simulating solver for n = 4, 6, 8, the pairs end up at -1 to 2n-2
+const std::vector<Move> EVEN_BASE[3] = {
+    {{6, -1}, {3, 6}, {0, 3}, {7, 0}},
+    {{10, -1}, {7, 10}, {2, 7}, {6, 2}, {0, 6}, {11, 0}},
+    {{14, -1}, {11, 14}, {4, 11}, {7, 4}, {0, 7}, {10, 0}, {3, 10}, {15, 3}},
+};
+
+/// every move fills the cells that were emptied by the previous one, the first fills -1
+void chainSources(const std::vector<int>& sources, std::vector<Move>& moves) {
+    int to = -1;
+    for (int from : sources) {
+        moves.push_back({from, to});
+        to = from;
+    }
+}
+
+void oddMoves(int n, std::vector<Move>& moves) {
+    if (n == 3) {
+        // the pairs end up at -3 to 2
+        moves.insert(moves.end(), {{2, -1}, {5, 2}, {3, -3}});
+        return;
+    }
+    std::vector<int> sources = {2*n - 2, n - 2, n + 1};
+    sources.reserve(n);
+    // then sources alternate between the left and the right side, starting on the left:
+    // left: 3, 7, ... up to n-4, then 0, 4, 8, ...
+    // right: n+5, n+9, ... up to 2n-4, then n+2, n+6, ...
+    int nbrLeft = (n - 3) / 2;
+    int nbrRight = (n - 5) / 2;
+    int left = 3, right = n + 5;
+    for (int i = 0; i < nbrLeft; ++i) {
+        if (left > n - 4) left = 0;
+        sources.push_back(left);
+        left += 4;
+        if (i < nbrRight) {
+            if (right > 2*n - 4) right = n + 2;
+            sources.push_back(right);
+            right += 4;
+        }
+    }
+    sources.push_back(2*n - 1);
+    chainSources(sources, moves);
+}
+
+void evenMoves(int n, std::vector<Move>& moves) {
+    assert(n >= 4);
+    // the pairs of level k start at s = 1 + 4k, with the empty cells s-2, s-1 in front of them:
+    // AB to the front, BA to the back, then m-4 pairs BABA... are left in [s+4, s+2m-5]
+    int nbrLevels = n > 8 ? (n - 5) / 4 : 0; // leaves n = 6 or 8
+    for (int k = 0, s = 1, m = n; k < nbrLevels; ++k, s += 4, m -= 4) {
+        moves.push_back({s + 2*m - 3, s - 2});
+        moves.push_back({s + 2, s + 2*m - 3});
+    }
+    int base = n - 4 * nbrLevels;
+    int offset = 4 * nbrLevels;
+    for (const Move& m : EVEN_BASE[(base - 4) / 2]) {
+        moves.push_back({m.from + offset, m.to + offset});
+    }
+    // the solved inner pairs end two cells to the left: BB in front of them, AA to the front
+    for (int k = nbrLevels - 1; k >= 0; --k) {
+        int s = 1 + 4*k, m = n - 4*k;
+        moves.push_back({s - 1, s + 2*m - 6});
+        moves.push_back({s + 2*m - 2, s - 1});
+    }
+}
+
+}
+
+std::vector<Move> closedFormMoves(int n) {
+    assert(n >= 3);
+    std::vector<Move> moves;
+    moves.reserve(n + 1);
+    if (n % 2 == 1) {
+        oddMoves(n, moves);
+    } else {
+        evenMoves(n, moves);
+    }
+    return moves;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Move.h"
+
+#include <vector>
+
+/* Moves of the solver for n pairs without simulating the line.
+ *
+ * The pairs start as BABA...BA at indices 1 to 2n with empty cells to the left.
+ * For odd n and for n = 4, 6, 8 the moves are the ones the simulating solver (Solver.cpp) finds:
+ * every move fills the cells emptied by the previous one and the sources follow arithmetic
+ * sequences on both sides of the line.
+ * For even n >= 10, where the simulating solver does not find a solution, the moves reduce n to n-4:
+ * two moves before and two moves after solving the inner 2(n-4) cells, down to n = 6 or 8.
+ * Each case uses n moves and ends at -1 to 2n-2, except n = 3, which ends at -3 to 2.
+ */
+std::vector<Move> closedFormMoves(int n);
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+/// moves the two cells at 'from' and 'from'+1 to the empty cells at 'to' and 'to'+1
+struct Move {
+    int from;
+    int to;
+};
+
+inline bool operator==(const Move& a, const Move& b) {
+    return a.from == b.from && a.to == b.to;
+}
+
+/* Writes moves as "<from> to <to>" lines through a block buffer,
+ * the buffer is flushed when it is full and on destruction
+ */
+class MoveWriter {
+public:
+    MoveWriter(FILE* out = stdout) : m_out(out), m_size(0) {}
+    ~MoveWriter() { flush(); }
+    void write(const Move& m) {
+        if (m_size + MAX_LINE > BUFFER_SIZE) {
+            flush();
+        }
+        writeInt(m.from);
+        m_buffer[m_size++] = ' ';
+        m_buffer[m_size++] = 't';
+        m_buffer[m_size++] = 'o';
+        m_buffer[m_size++] = ' ';
+        writeInt(m.to);
+        m_buffer[m_size++] = '\n';
+    }
+    void write(const std::vector<Move>& moves) {
+        for (const Move& m : moves) write(m);
+    }
+    void flush() {
+        fwrite(m_buffer, 1, m_size, m_out);
+        fflush(m_out);
+        m_size = 0;
+    }
+private:
+    static constexpr int BUFFER_SIZE = 1 << 16;
+    static constexpr int MAX_LINE = 2 * 11 + 5; // two signed ints, " to " and '\n'
+    void writeInt(int x) {
+        unsigned int u = x;
+        if (x < 0) {
+            m_buffer[m_size++] = '-';
+            u = -u;
+        }
+        char digits[10];
+        int nbrDigits = 0;
+        do {
+            digits[nbrDigits++] = '0' + u % 10;
+            u /= 10;
+        } while (u);
+        while (nbrDigits) m_buffer[m_size++] = digits[--nbrDigits];
+    }
+    FILE* m_out;
+    int m_size;
+    char m_buffer[BUFFER_SIZE];
+};
+
+/* Reads "<from> to <to>" lines (as written by MoveWriter) through a block buffer */
+class MoveReader {
+public:
+    MoveReader(FILE* in = stdin) : m_in(in), m_pos(0), m_size(0) {}
+    bool read(Move& m) {
+        /// false at the end of the input or if the next move is malformed (see 'malformed')
+        m_malformed = false;
+        skipSpace();
+        if (peek() == EOF) {
+            return false;
+        }
+        if (!readInt(m.from) || !readWord("to") || !readInt(m.to)) {
+            m_malformed = true;
+            return false;
+        }
+        return true;
+    }
+    bool malformed() const { return m_malformed; }
+    std::vector<Move> readAll() {
+        std::vector<Move> moves;
+        Move m;
+        while (read(m)) moves.push_back(m);
+        return moves;
+    }
+private:
+    static constexpr int BUFFER_SIZE = 1 << 16;
+    int peek() {
+        if (m_pos == m_size) {
+            m_size = fread(m_buffer, 1, BUFFER_SIZE, m_in);
+            m_pos = 0;
+            if (m_size == 0) return EOF;
+        }
+        return static_cast<unsigned char>(m_buffer[m_pos]);
+    }
+    void skipSpace() {
+        for (int c = peek(); c == ' ' || c == '\n' || c == '\r' || c == '\t'; c = peek()) ++m_pos;
+    }
+    bool readInt(int& x) {
+        skipSpace();
+        bool negative = peek() == '-';
+        if (negative) ++m_pos;
+        if (peek() < '0' || peek() > '9') return false;
+        long long value = 0;
+        const long long limit = negative ? 1LL << 31 : (1LL << 31) - 1; // range of int
+        for (int c = peek(); c >= '0' && c <= '9'; c = peek()) {
+            value = value * 10 + (c - '0');
+            if (value > limit) return false;
+            ++m_pos;
+        }
+        x = static_cast<int>(negative ? -value : value);
+        return true;
+    }
+    bool readWord(const char* word) {
+        skipSpace();
+        for (; *word; ++word, ++m_pos) {
+            if (peek() != *word) return false;
+        }
+        return true;
+    }
+    FILE* m_in;
+    int m_pos;
+    int m_size;
+    bool m_malformed = false;
+    char m_buffer[BUFFER_SIZE];
+};
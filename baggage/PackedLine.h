@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+enum class ElemType {
+    B = 0,
+    A = 1,
+    EMPTY = 2
+};
+
+/* Line of cells with indices [first, last], stored with 2 bits per cell (32 cells per word).
+ * Cells behind 'last' are padded with the unused code 3, so they never match an ElemType.
+ */
+class PackedLine {
+public:
+    PackedLine(int first, int last) {
+        reset(first, last);
+    }
+    void reset(int first, int last) {
+        /// empties the line and changes its range, keeps the allocated words
+        m_first = first;
+        m_last = last;
+        m_words.assign((last - first + 1 + CELLS_PER_WORD - 1) / CELLS_PER_WORD + 1,
+                       static_cast<uint64_t>(ElemType::EMPTY) * LOW_BITS);
+        for (int pos = last - first + 1; pos < static_cast<int>(m_words.size()) * CELLS_PER_WORD; ++pos) {
+            m_words[pos / CELLS_PER_WORD] |= 3ULL << (2 * (pos % CELLS_PER_WORD)); // padding
+        }
+    }
+    int first() const { return m_first; }
+    int last() const { return m_last; }
+    ElemType get(int idx) const {
+        assert(idx >= m_first && idx <= m_last);
+        int pos = idx - m_first;
+        return static_cast<ElemType>((m_words[pos / CELLS_PER_WORD] >> (2 * (pos % CELLS_PER_WORD))) & 3);
+    }
+    void set(int idx, ElemType e) {
+        assert(idx >= m_first && idx <= m_last);
+        int pos = idx - m_first;
+        uint64_t& word = m_words[pos / CELLS_PER_WORD];
+        int shift = 2 * (pos % CELLS_PER_WORD);
+        word = (word & ~(3ULL << shift)) | (static_cast<uint64_t>(e) << shift);
+    }
+    int firstNonEmpty() const;
+        /// smallest idx with a cell that is not empty, last() + 1 if all cells are empty
+private:
+    static constexpr int CELLS_PER_WORD = 32;
+    static constexpr uint64_t LOW_BITS = 0x5555555555555555ULL; // lower bit of each cell
+    uint64_t matches(int w, ElemType e) const {
+        /// bit 2k is set if cell k of word w equals e
+        uint64_t same = ~(m_words[w] ^ (static_cast<uint64_t>(e) * LOW_BITS));
+        return same & (same >> 1) & LOW_BITS;
+    }
+    int m_first;
+    int m_last;
+    std::vector<uint64_t> m_words; // one extra word of padding, so that pairs can look at the next word
+};
+
+inline int PackedLine::firstNonEmpty() const {
+    int nbrWords = (m_last - m_first) / CELLS_PER_WORD + 1;
+    for (int w = 0; w < nbrWords; ++w) {
+        uint64_t nonEmpty = ~matches(w, ElemType::EMPTY) & LOW_BITS;
+        if (nonEmpty) {
+            return std::min(m_last + 1, m_first + w * CELLS_PER_WORD + __builtin_ctzll(nonEmpty) / 2);
+        }
+    }
+    return m_last + 1;
+}
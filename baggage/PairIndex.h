@@ -0,0 +1,116 @@
+#pragma once
+
+#include "PackedLine.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/* Set of integers in [0, size) as a hierarchy of 64-ary bitsets: bit i of level l+1 is set
+ * if word i of level l is not zero. Insert, erase and successor queries take
+ * O(log_64 size) steps (4 levels for 16M elements).
+ */
+class SuccessorSet {
+public:
+    explicit SuccessorSet(int size = 0) {
+        reset(size);
+    }
+    void reset(int size) {
+        /// empties the set for elements 0 to size-1, keeps the allocated levels
+        int nbrBits = std::max(size, 1);
+        int nbrLevels = 0;
+        do {
+            if (nbrLevels == static_cast<int>(m_levels.size())) m_levels.emplace_back();
+            m_levels[nbrLevels].assign((nbrBits + 63) / 64, 0);
+            nbrBits = m_levels[nbrLevels++].size();
+        } while (nbrBits > 1);
+        m_levels.resize(nbrLevels);
+    }
+    void insert(int i) {
+        for (std::vector<uint64_t>& level : m_levels) {
+            bool wasEmpty = level[i >> 6] == 0;
+            level[i >> 6] |= 1ULL << (i & 63);
+            if (!wasEmpty) break;
+            i >>= 6;
+        }
+    }
+    void erase(int i) {
+        for (std::vector<uint64_t>& level : m_levels) {
+            level[i >> 6] &= ~(1ULL << (i & 63));
+            if (level[i >> 6] != 0) break;
+            i >>= 6;
+        }
+    }
+    bool contains(int i) const { return m_levels[0][i >> 6] & (1ULL << (i & 63)); }
+    int next(int i) const {
+        /// smallest element >= i, -1 if there is none
+        for (int l = 0; l < static_cast<int>(m_levels.size()); ++l) {
+            if ((i >> 6) >= static_cast<int>(m_levels[l].size())) {
+                return -1;
+            }
+            uint64_t word = m_levels[l][i >> 6] & (~0ULL << (i & 63));
+            if (word) {
+                i = (i & ~63) | __builtin_ctzll(word);
+                for (--l; l >= 0; --l) {
+                    i = i << 6 | __builtin_ctzll(m_levels[l][i]);
+                }
+                return i;
+            }
+            i = (i >> 6) + 1; // the next word of this level is the next bit of the level above
+        }
+        return -1;
+    }
+private:
+    std::vector<std::vector<uint64_t>> m_levels; // m_levels[0]: one bit per element
+};
+
+/* Start indices of the pairs AA, AB, BA and BB of a PackedLine, a pair at idx consists of
+ * the cells idx and idx+1. Moving two cells changes the pairs starting at up to six indices,
+ * they are updated by 'refresh'.
+ */
+class PairIndex {
+public:
+    explicit PairIndex(const PackedLine& line) {
+        reset(line);
+    }
+    void reset(const PackedLine& line) {
+        /// re-reads all pairs of 'line', keeps the allocated sets
+        m_first = line.first();
+        m_last = line.last();
+        for (SuccessorSet& set : m_pairs) set.reset(m_last - m_first + 1);
+        for (int idx = m_first; idx < m_last; ++idx) {
+            refresh(line, idx);
+        }
+    }
+    void refresh(const PackedLine& line, int idx) {
+        /// re-reads the pair starting at idx
+        if (idx < m_first || idx >= m_last) return;
+        int pos = idx - m_first;
+        for (SuccessorSet& set : m_pairs) set.erase(pos);
+        ElemType x = line.get(idx), y = line.get(idx + 1);
+        if (x != ElemType::EMPTY && y != ElemType::EMPTY) {
+            m_pairs[slot(x, y)].insert(pos);
+        }
+    }
+    void refreshMove(const PackedLine& line, int from, int to) {
+        /// updates the pairs after the cells from, from+1 were moved to to, to+1
+        for (int idx : {from - 1, from, from + 1, to - 1, to, to + 1}) {
+            refresh(line, idx);
+        }
+    }
+    int next(ElemType x, ElemType y, int from, int to) const {
+        /// smallest idx in [from, to] at which the pair (x, y) starts, to + 1 if there is none
+        assert(x != ElemType::EMPTY && y != ElemType::EMPTY);
+        int pos = m_pairs[slot(x, y)].next(std::max(from, m_first) - m_first);
+        if (pos < 0 || pos + m_first > to) {
+            return to + 1;
+        }
+        return pos + m_first;
+    }
+private:
+    static int slot(ElemType x, ElemType y) { return static_cast<int>(x) * 2 + static_cast<int>(y); }
+    int m_first;
+    int m_last;
+    std::array<SuccessorSet, 4> m_pairs; // by slot(x, y)
+};
@@ -0,0 +1,195 @@
+#include "Search.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+/// bit i: cell with index i + offset, offset = -2n+1
+struct LineState {
+    uint64_t occupied;
+    uint64_t a;
+    bool operator==(const LineState& other) const { return occupied == other.occupied && a == other.a; }
+};
+
+struct LineStateHash {
+    size_t operator()(const LineState& s) const {
+        uint64_t x = s.occupied * 0x9E3779B97F4A7C15ULL ^ s.a;
+        x ^= x >> 31;
+        x *= 0xBF58476D1CE4E5B9ULL;
+        return x ^ (x >> 29);
+    }
+};
+
+struct Problem {
+    int n;
+    int offset;         // index of the cell of bit 0
+    uint64_t cells;     // bits of the cells of the line
+    LineState start;
+
+    explicit Problem(int n) : n(n), offset(-2*n + 1), cells(4*n == 64 ? ~0ULL : (1ULL << 4*n) - 1) {
+        start = {0, 0};
+        for (int idx = 1; idx <= 2*n; ++idx) {
+            start.occupied |= 1ULL << (idx - offset);
+            if (idx % 2 == 0) start.a |= 1ULL << (idx - offset);
+        }
+    }
+    bool isGoal(const LineState& s) const {
+        int first = __builtin_ctzll(s.occupied);
+        uint64_t elements = (1ULL << 2*n) - 1;
+        return s.occupied >> first == elements && s.a >> first == (1ULL << n) - 1;
+    }
+    int heuristic(const LineState& s) const {
+        uint64_t b = s.occupied & ~s.a;
+        int g = __builtin_popcountll(s.a & (s.a >> 1)) + __builtin_popcountll(b & (b >> 1)) + ((s.a & (b >> 1)) != 0);
+        return (2*n - 1 - g + 1) / 2;
+    }
+    /// calls f(from bit, to bit, next state) for all moves of 's'
+    template <typename F>
+    void forEachMove(const LineState& s, F f) const {
+        uint64_t sources = s.occupied & (s.occupied >> 1);
+        uint64_t free = ~s.occupied & cells;
+        uint64_t targets = free & (free >> 1);
+        for (uint64_t src = sources; src; src &= src - 1) {
+            int from = __builtin_ctzll(src);
+            uint64_t pair = 3ULL << from;
+            uint64_t pairA = s.a & pair;
+            LineState removed{s.occupied & ~pair, s.a & ~pair};
+            for (uint64_t dst = targets; dst; dst &= dst - 1) {
+                int to = __builtin_ctzll(dst);
+                LineState next{removed.occupied | 3ULL << to, removed.a | pairA >> from << to};
+                f(from, to, next);
+            }
+        }
+    }
+};
+
+struct Node {
+    LineState state;
+    std::vector<Move> path;
+};
+
+/* Depth first search of one thread below the frontier */
+class Worker {
+public:
+    Worker(const Problem& problem, std::atomic<bool>& solved) : m_problem(problem), m_solved(solved), m_nbrNodes(0) {}
+    /// returns true if a solution with at most 'bound' moves was found (in 'path'),
+    /// otherwise 'nextBound' is lowered to the smallest f above 'bound'
+    bool search(const LineState& s, std::vector<Move>& path, int bound, int& nextBound) {
+        if (m_solved.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        int g = path.size();
+        int f = g + m_problem.heuristic(s);
+        if (f > bound) {
+            nextBound = std::min(nextBound, f);
+            return false;
+        }
+        if (m_problem.isGoal(s)) {
+            return true;
+        }
+        auto it = m_visited.find(s);
+        if (it != m_visited.end() && it->second <= g) {
+            return false;
+        }
+        m_visited[s] = g;
+        ++m_nbrNodes;
+        bool found = false;
+        m_problem.forEachMove(s, [&](int from, int to, const LineState& next) {
+            if (found) return;
+            path.push_back({from + m_problem.offset, to + m_problem.offset});
+            found = search(next, path, bound, nextBound);
+            if (!found) path.pop_back();
+        });
+        return found;
+    }
+    void clear() { m_visited.clear(); }
+    int64_t nbrNodes() const { return m_nbrNodes; }
+private:
+    const Problem& m_problem;
+    std::atomic<bool>& m_solved;
+    std::unordered_map<LineState, int, LineStateHash> m_visited; // fewest moves to the state in this iteration
+    int64_t m_nbrNodes;
+};
+
+}
+
+SearchResult findShortestSolution(int n, const SearchParams& params) {
+    assert(n >= 1 && 4*n <= 64);
+    Problem problem(n);
+    int maxMoves = params.maxMoves > 0 ? params.maxMoves : 2*n;
+    int nbrThreads = params.nbrThreads > 0 ? params.nbrThreads : std::max(1u, std::thread::hardware_concurrency());
+    SearchResult result{false, {}, 0};
+
+    // breadth first search up to the frontier, solutions above it are found here
+    std::vector<Node> frontier = {{problem.start, {}}};
+    std::unordered_set<LineState, LineStateHash> seen = {problem.start};
+    for (int depth = 0; ; ++depth) {
+        for (const Node& node : frontier) {
+            if (problem.isGoal(node.state)) {
+                result.found = true;
+                result.moves = node.path;
+                return result;
+            }
+        }
+        if (depth == std::min(params.frontierDepth, maxMoves)) {
+            break;
+        }
+        std::vector<Node> next;
+        for (const Node& node : frontier) {
+            ++result.nbrNodes;
+            problem.forEachMove(node.state, [&](int from, int to, const LineState& s) {
+                if (seen.insert(s).second) {
+                    next.push_back({s, node.path});
+                    next.back().path.push_back({from + problem.offset, to + problem.offset});
+                }
+            });
+        }
+        frontier.swap(next);
+    }
+    if (frontier.empty() || static_cast<int>(frontier.front().path.size()) >= maxMoves) {
+        return result;
+    }
+
+    // IDA* below the frontier, in parallel over the frontier nodes
+    std::atomic<bool> solved(false);
+    std::mutex resultMutex;
+    std::vector<Worker> workers;
+    for (int t = 0; t < nbrThreads; ++t) workers.emplace_back(problem, solved);
+    int depth = frontier.front().path.size();
+    int bound = maxMoves + 1;
+    for (const Node& node : frontier) {
+        bound = std::min(bound, depth + problem.heuristic(node.state));
+    }
+    bound = std::max(bound, depth + 1); // shorter solutions would have been found by the breadth first search
+    while (bound <= maxMoves && !solved) {
+        std::atomic<int> nextItem(0);
+        std::vector<int> nextBounds(nbrThreads, maxMoves + 1);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < nbrThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                workers[t].clear();
+                for (int i = nextItem++; i < static_cast<int>(frontier.size()) && !solved; i = nextItem++) {
+                    std::vector<Move> path = frontier[i].path;
+                    if (workers[t].search(frontier[i].state, path, bound, nextBounds[t])) {
+                        std::lock_guard<std::mutex> lock(resultMutex);
+                        if (!solved) {
+                            solved = true;
+                            result.moves = path;
+                        }
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        bound = *std::min_element(nextBounds.begin(), nextBounds.end());
+    }
+    for (const Worker& worker : workers) result.nbrNodes += worker.nbrNodes();
+    result.found = solved;
+    return result;
+}
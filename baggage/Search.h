@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Move.h"
+
+#include <cstdint>
+#include <vector>
+
+/* Exhaustive search for a shortest move list for small n.
+ *
+ * The search runs on the line of the solver (indices -2n+1 to 2n, so n <= 16), a state is
+ * a bitmask of the occupied cells and a bitmask of the cells holding an A.
+ * IDA* with the heuristic ceil((2n-1 - g) / 2), where g counts the adjacent AA and BB cells plus
+ * one if there is an adjacent AB: the goal has g = 2n-1 and a move creates at most two adjacencies.
+ * The states after 'frontierDepth' moves are collected by a breadth first search (without duplicates)
+ * and expanded by 'nbrThreads' threads, each with its own transposition table
+ * (state -> fewest moves it was reached with in the current iteration).
+ */
+struct SearchParams {
+    int maxMoves = 0;       // give up after searching all move lists of this length, 0: 2n
+    int nbrThreads = 0;     // 0: hardware concurrency
+    int frontierDepth = 2;  // depth of the breadth first search that creates the work items
+};
+
+struct SearchResult {
+    bool found;
+    std::vector<Move> moves;    // a shortest move list if found
+    int64_t nbrNodes;           // states expanded in all iterations
+};
+
+SearchResult findShortestSolution(int n, const SearchParams& params);
@@ -0,0 +1,48 @@
+#include "ClosedForm.h"
+#include "Search.h"
+#include "Verifier.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+/// Finds shortest move lists for small n and compares them with the move count of the solver
+// usage: shortestBaggage nMin [nMax] [nbrThreads] [frontierDepth]
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: shortestBaggage nMin [nMax] [nbrThreads] [frontierDepth]" << std::endl;
+        return 2;
+    }
+    int nMin = std::atoi(argv[1]);
+    int nMax = argc > 2 ? std::atoi(argv[2]) : nMin;
+    SearchParams params;
+    params.nbrThreads = argc > 3 ? std::atoi(argv[3]) : 0;
+    params.frontierDepth = argc > 4 ? std::atoi(argv[4]) : params.frontierDepth;
+    if (nMin < 3 || nMax > 16) {
+        std::cerr << "Error: n must be in [3, 16]" << std::endl;
+        return 2;
+    }
+    bool allOptimal = true;
+    for (int n = nMin; n <= nMax; ++n) {
+        auto t = std::chrono::steady_clock::now();
+        SearchResult result = findShortestSolution(n, params);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+        int solverMoves = closedFormMoves(n).size();
+        std::cout << "n = " << n << ": ";
+        if (!result.found) {
+            std::cout << "no solution with at most " << 2*n << " moves";
+        } else {
+            VerifyResult check = verifyMoves(n, result.moves);
+            bool optimal = solverMoves == static_cast<int>(result.moves.size());
+            allOptimal &= optimal && check.ok;
+            std::cout << "shortest " << result.moves.size() << " moves, solver " << solverMoves
+                << (optimal ? " (optimal)" : " (NOT OPTIMAL)");
+            if (!check.ok) std::cout << " VERIFICATION FAILED: " << check.error;
+        }
+        std::cout << ", " << result.nbrNodes << " nodes, " << seconds << " s" << std::endl;
+        if (result.found) {
+            for (const Move& m : result.moves) std::cout << "  " << m.from << " to " << m.to << std::endl;
+        }
+    }
+    return allOptimal ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+#include "Solver.h"
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <math.h>
+
+#define DEBUG 0
+
+std::ostream& operator<<(std::ostream& os, ElemType x) {
+    switch (x) {
+        case ElemType::B:
+            os << "B";
+            break;
+        case ElemType::A:
+            os << "A";
+            break;
+        case ElemType::EMPTY:
+            os << " ";
+            break;
+    }
+    return os;
+}
+
+bool Data::isInvalid(int idx, ElemType eType, const std::pair<ElemType, ElemType>& foundPair, bool isLastMove) {
+    return wouldSplit(idx, eType, foundPair) || wouldCreateTriplet(idx, eType, foundPair, isLastMove);
+    // wouldCreateTriplet: necessary for n = 8. but destroys n = 6 because triplet is actually never created because next move aint possible
+}
+
+bool Data::wouldCreateTriplet(int idx, ElemType eType, const std::pair<ElemType, ElemType>& foundPair, bool isLastMove) {
+    if (isLastMove) {
+        // we're not doing another AB/BA swap: triplet creation wont occur!
+        return false;
+    }
+    bool triplet = false; // whether triplet would be created in next move
+    bool prevPossible = idx - data.first() >= 2;
+    bool nextPossible = idx + 2 <= data.last();
+    if (onLeftSide(idx)) {
+        // left side move
+        if (foundPair.first == ElemType::A && foundPair.second == ElemType::B) {
+            // AB found, check for BB on left 
+            if (prevPossible && data.get(idx-2) == eType && data.get(idx-1) == eType) {
+                triplet = true;
+            }
+        } else if (foundPair.first == ElemType::B && foundPair.second == ElemType::A) {
+            // BA found, check for BB on right
+            if (nextPossible && data.get(idx+2) == eType && data.get(idx+1) == eType) {
+                triplet = true;
+            }
+        }
+    } else {
+        // right side move
+        if (foundPair.first == ElemType::A && foundPair.second == ElemType::B) {
+            // AB found, check for AA on the right
+            if (nextPossible && data.get(idx+2) == eType && data.get(idx+1) == eType) {
+                triplet = true;
+            }
+        } else if (foundPair.first == ElemType::B && foundPair.second == ElemType::A) {
+            // BA found, check for AA on the left
+            if (prevPossible && data.get(idx-2) == eType && data.get(idx-1) == eType) {
+                triplet = true;
+            }
+        }
+    }
+    #if DEBUG
+    std::cout << "triplet status: " << triplet << std::endl;
+    #endif
+    return triplet;
+}
+
+bool Data::onLeftSide(int idx) {
+    if (idx >= startOfRightSide) {
+        return false;
+    } else {
+        return true;
+    }
+}
+
+bool Data::wouldSplit(int idx, ElemType eType, const std::pair<ElemType, ElemType>& foundPair) {
+    bool split = false;
+
+    if (idx > data.first() && (foundPair.first == eType && data.get(idx-1) == eType)) {
+        // BB on the left of found pair would be split
+        split = true;
+    } else if (idx + 2 <= data.last() && foundPair.second == eType && data.get(idx+2) == eType) {
+        // BB on the right of found pair would be split
+        split = true;
+    }
+    #if DEBUG
+    std::cout << "split status: " << split << std::endl;
+    #endif
+    return split;
+}
+
+int Data::findPair(std::pair<ElemType, ElemType> p, int start, int end, bool isLastMove) {
+    #if DEBUG
+        std::cout << "Searching: " << p.first << p.second << " in [" << start << "," << end << "]" << std::endl;
+    #endif
+    bool preventSplits = p.first != p.second;
+    assert(start >= data.first() && start <= data.last()); // element must exist
+    assert(end >= data.first() && end <= data.last()); // element must exist
+    // closed interval to the right
+    int idx;
+    if (!preventSplits) {
+        idx = pairs.next(p.first, p.second, start, end);
+    } else {
+        // AB/BA pairs that would cause trouble are not in validPairs
+        int pos = validPairs[validSlot(p, isLastMove)].next(start - data.first());
+        idx = pos < 0 ? end + 1 : pos + data.first();
+    }
+    if (idx > end) {
+        return NOT_FOUND;
+    }
+    #if DEBUG
+    std::cout << "found pair: " << p.first << ", " << p.second << std::endl;
+    #endif
+    return idx;
+}
+
+int Data::validSlot(const std::pair<ElemType, ElemType>& p, bool isLastMove) {
+    assert(p.first != p.second);
+    return 2 * isLastMove + (p.first == ElemType::B);
+}
+
+void Data::refreshValidity(int idx) {
+    if (idx < data.first() || idx >= data.last()) {
+        return;
+    }
+    int pos = idx - data.first();
+    auto foundPair = std::make_pair(data.get(idx), data.get(idx+1));
+    for (auto p : {std::make_pair(ElemType::A, ElemType::B), std::make_pair(ElemType::B, ElemType::A)}) {
+        for (bool isLastMove : {false, true}) {
+            // do not cause trouble on the left side (B's) or on the right side (A's)
+            ElemType eType = onLeftSide(idx) ? ElemType::B : ElemType::A;
+            if (foundPair == p && !isInvalid(idx, eType, p, isLastMove)) {
+                validPairs[validSlot(p, isLastMove)].insert(pos);
+            } else {
+                validPairs[validSlot(p, isLastMove)].erase(pos);
+            }
+        }
+    }
+}
+
+int Data::move(int from, int to) {
+    assert(from >= data.first() && from+1 <= data.last());
+    assert(to >= data.first() && to+1 <= data.last());
+
+    assert(data.get(to) == ElemType::EMPTY &&
+           data.get(to+1) == ElemType::EMPTY);
+    assert(data.get(from) != ElemType::EMPTY &&
+           data.get(from+1) != ElemType::EMPTY);
+   
+    data.set(to, data.get(from));
+    data.set(to+1, data.get(from+1));
+    data.set(from, ElemType::EMPTY);
+    data.set(from+1, ElemType::EMPTY);
+    pairs.refreshMove(data, from, to);
+    for (int idx = from - 2; idx <= from + 3; ++idx) refreshValidity(idx);
+    for (int idx = to - 2; idx <= to + 3; ++idx) refreshValidity(idx);
+
+    moves.push_back({from, to});
+    #if DEBUG
+        std::cout << from << " to " << to << std::endl;
+        print();
+    #endif
+    return from; // returns the last input source
+}
+
+void Data::print() {
+    int printFromIdx = std::max(-2, data.first());
+    for (int idx = printFromIdx; idx <= data.last(); ++idx) {
+        std::string sep = "|";
+        if (idx == N - 2) {
+            sep = "#";
+        }
+        std::cout << idx << sep;
+    }
+    std::cout << std::endl;
+
+    for (int idx = printFromIdx; idx <= data.last(); ++idx) {
+        int charSize = std::to_string(idx).size(); // for padding
+        std::string padding = std::string(charSize - 1, ' ');
+        std::string sep = "|";
+        if (idx == N - 2) {
+            sep = "#"; 
+        }
+        std::cout << data.get(idx) << padding << sep;
+    }
+    std::cout << std::endl;
+}
+
+void Data::init(int n) {
+    int N = n*2*2;
+    for (int i = 0; i < N; ++i) {
+        ElemType elemType;
+        if (i < 2*n) {
+            // init empty cells
+            elemType = ElemType::EMPTY;
+        } else {
+            // alternating elements
+            elemType = static_cast<ElemType>(i % 2);
+        }
+        int usedIdx = i - 2*n + 1;
+        data.set(usedIdx, elemType);
+    }
+    K = 2*n;
+    this->N = n;
+    startOfRightSide = n - 1;
+    pairs.reset(data);
+    for (SuccessorSet& valid : validPairs) valid.reset(data.last() - data.first() + 1);
+    for (int idx = data.first(); idx < data.last(); ++idx) {
+        refreshValidity(idx);
+    }
+}
+
+void Data::reset(int n) {
+    data.reset(-2*n + 1, 2*n);
+    moves.clear();
+    init(n);
+}
+
+int solveIter(Data& data, int stopIter,
+              std::pair<ElemType, ElemType> item1,
+              std::pair<ElemType, ElemType> item2,
+              int lastSource) {
+    int moveIters = 0;
+    for (; moveIters < stopIter; ++moveIters) {
+        // solve second phase (same for even)
+        // determine side with empty cells
+        int s,e;
+        std::pair<ElemType, ElemType> item;
+        if (data.onLeftSide(lastSource)) {
+            // empty cells on the left side -> search on the right side
+            item = item1;
+            s = data.startOfRightSide; // TODO original def
+            /*
+            if (item.first == ElemType::B && item.second == ElemType::A) {
+                s = data.startOfRightSide;
+            } else {
+                s = data.startOfRightSide +1;
+            }
+            */
+            e = data.K;
+        } else {
+            // empty cells on the right side -> search on the left side
+            item = item2;
+            s = -1;
+            e = data.startOfRightSide -1;
+        }
+        bool isLastMoveInPhase = moveIters+1 == stopIter;
+        int pairIdx = data.findPair(item, s, e, isLastMoveInPhase);
+        if (pairIdx == Data::NOT_FOUND) {
+            #if DEBUG
+            std::cout << "Error: Did not find pair!" << std::endl;    
+            #endif
+            break;
+        } else {
+            #if DEBUG
+            std::cout << "Found pair at: " << pairIdx << std::endl;
+            #endif
+            lastSource = data.move(pairIdx, lastSource);
+        }
+    }
+    return lastSource;
+}
+
+void solveEven(Data& data, int lastSource) {
+    #if DEBUG
+    std::cout << "SECOND STEP" << std::endl;
+    #endif
+    lastSource = data.move(data.K-5, lastSource); // move BA to right
+    #if DEBUG
+    std::cout << std::endl;
+    std::cout << "FIRST PHASE" << std::endl;
+    #endif
+
+    // search AB/BA that doesnt split pairs
+    lastSource = solveIter(data, ceil(static_cast<double>(data.N) / 2) - 2, 
+              std::make_pair(ElemType::B, ElemType::A),
+              std::make_pair(ElemType::A, ElemType::B), lastSource); // used lastSource before
+    #if DEBUG
+    std::cout << std::endl;
+    std::cout << "SECOND PHASE" << std::endl;
+    #endif
+    // search AA/BB 
+    lastSource = solveIter(data, data.N / 2, std::make_pair(ElemType::A, ElemType::A),
+              std::make_pair(ElemType::B, ElemType::B), lastSource);
+
+ 
+}
+void solveUneven(Data& data, int lastSource) {
+    #if DEBUG
+    std::cout << "SECOND STEP" << std::endl;
+    #endif
+    lastSource = data.move(data.N-2, lastSource);
+    #if DEBUG
+    std::cout << std::endl;
+    std::cout << "FIRST PHASE" << std::endl;
+    #endif
+    // search AB/BA that doesnt split pairs
+    lastSource = solveIter(data, ceil(static_cast<double>(data.N) / 2) - 2, 
+              std::make_pair(ElemType::A, ElemType::B),
+              std::make_pair(ElemType::B, ElemType::A), lastSource);
+    #if DEBUG
+    std::cout << std::endl;
+    std::cout << "SECOND PHASE" << std::endl;
+    #endif
+    // search AA/BB 
+    lastSource = solveIter(data, data.N / 2, std::make_pair(ElemType::A, ElemType::A),
+              std::make_pair(ElemType::B, ElemType::B), lastSource);
+}
+
+void solve(Data& data) {
+    if (data.N == 3) {
+        // special case: the only n whose shortest solution does not end at -1,
+        // the pairs end up at -3 to 2 after 3 moves
+        data.move(2, -1);
+        data.move(5, 2);
+        data.move(3, -3);
+        return;
+    }
+    // first move
+    #if DEBUG
+    data.print();
+    std::cout << "FIRST STEP" << std::endl;
+    #endif
+    int lastSource = data.move(data.K-2, -1);
+
+    if (data.N % 2 == 0) {
+        // even
+        solveEven(data, lastSource);
+    } else {
+        // odd
+        solveUneven(data, lastSource);
+    }
+}
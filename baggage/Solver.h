@@ -0,0 +1,76 @@
+#pragma once
+
+#include "PackedLine.h"
+#include "PairIndex.h"
+#include "Move.h"
+
+#include <array>
+#include <climits>
+#include <iostream>
+#include <vector>
+
+std::ostream& operator<<(std::ostream& os, ElemType x);
+
+struct Data {
+    Data(int n ) : data(-2*n + 1, 2*n), pairs(data) {
+        init(n);
+    }
+    PackedLine data; // used index to element
+        /// elements are stored startin from idx 1 to idx K
+        // before these elements, there are K empty cells with
+        // indices from -K+1 to 0
+    PairIndex pairs; // start indices of the pairs in data, updated by move
+    std::array<SuccessorSet, 4> validPairs; // start positions (idx - data.first()) of AB/BA pairs which are not invalid
+        /// indexed by validSlot, updated by move
+    int N; // number of pairs
+        /// there are N pairs of BA's
+    int K; // number of non-empty map elements
+        // K = N*2
+    int startOfRightSide; 
+        /// index at which the 'right side' of the array starts
+        // the right side is the side where all the B's should accumulate
+
+    void init(int n);
+        /// initializes data with alternating entries
+    void reset(int n);
+        /// re-initializes data for n pairs and clears the moves, reuses the allocated memory
+        // the memory grows to the largest n seen, so start with the largest n to avoid reallocations
+    void print();
+        /// print out the data
+    std::vector<Move> moves; // moves performed so far
+    int move(int from, int to);
+        /// move two values 'from' to a free location 'to' (idx in array)
+        // records the move
+    static constexpr int NOT_FOUND = INT_MIN;
+    int findPair(std::pair<ElemType, ElemType> p, int start, int end, bool isLastMove);
+        /// returns the index of pair p in data, NOT_FOUND if there is no valid one
+    static int validSlot(const std::pair<ElemType, ElemType>& p, bool isLastMove);
+    void refreshValidity(int idx);
+        /// re-evaluates whether the AB/BA pair at idx is invalid (for both values of isLastMove)
+        // depends on the cells idx-2 to idx+3 only
+    bool onLeftSide(int idx);
+        /// whether idx lies on left side (goal: only A's) or right side of the array
+    bool wouldSplit(int idx, ElemType eType, const std::pair<ElemType, ElemType>& foundPair);
+        /// whether moval of the elements located at idx and idx+1 would lead to a split
+        // idx: the position considered for moval
+        // eType: the element type to be checked for splitting
+        // foundPair: the pair to be moved
+        //  e.g. A|AB|A: split of AA on the left
+        //  e.g. B|AB|B: split of BB on the right
+    bool wouldCreateTriplet(int idx, ElemType eType, const std::pair<ElemType, ElemType>& foundPair, bool isLastMove);
+        /// Checks whether a move would create a triplet in the next move
+        // triplets cant be moved later on (uneven number of elements) and cause problems in this way
+    bool isInvalid(int idx, ElemType eType, const std::pair<ElemType, ElemType>& foundPair, bool isLastMove);
+        /// checks for potential splits and triplet creation
+        // splits and triplet creation are not allowed
+};
+
+int solveIter(Data& data, int stopIter,
+              std::pair<ElemType, ElemType> item1,
+              std::pair<ElemType, ElemType> item2,
+              int lastSource);
+    /// performs up to stopIter moves of pairs item1 (from the right side) or item2 (from the left side)
+void solveEven(Data& data, int lastSource);
+void solveUneven(Data& data, int lastSource);
+void solve(Data& data);
+    /// simulates the moves for data.N pairs, they are recorded in data.moves
@@ -0,0 +1,64 @@
+#include "Sweep.h"
+#include "Solver.h"
+#include "ClosedForm.h"
+#include "Verifier.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+std::vector<SweepRow> runSweep(int nMin, int nMax, int nbrThreads, bool closedForm) {
+    if (nbrThreads <= 0) {
+        nbrThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<SweepRow> rows(std::max(0, nMax - nMin + 1));
+    std::atomic<int> next(0);
+    auto work = [&]() {
+        using clock = std::chrono::steady_clock;
+        Data data(std::max(nMax, 1)); // scratch line of this thread, sized for the largest n
+        std::vector<Move> moves;
+        for (int i = next++; i < static_cast<int>(rows.size()); i = next++) {
+            int n = nMin + i;
+            auto t = clock::now();
+            if (closedForm) {
+                moves = closedFormMoves(n);
+            } else {
+                data.reset(n);
+                solve(data);
+                moves.swap(data.moves);
+            }
+            auto t2 = clock::now();
+            VerifyResult result = verifyMoves(n, moves);
+            auto t3 = clock::now();
+            rows[i] = {n, static_cast<int>(moves.size()), result.ok, result.error,
+                       std::chrono::duration<double>(t2 - t).count(), std::chrono::duration<double>(t3 - t2).count()};
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nbrThreads; ++t) threads.emplace_back(work);
+    for (std::thread& thread : threads) thread.join();
+    return rows;
+}
+
+int printSweep(const std::vector<SweepRow>& rows, std::ostream& os) {
+    int nbrFailures = 0;
+    double solveSeconds = 0.0, verifySeconds = 0.0;
+    os << std::setw(8) << "n" << std::setw(9) << "moves" << std::setw(7) << "result"
+       << std::setw(12) << "solve ms" << std::setw(12) << "verify ms" << '\n';
+    os << std::fixed << std::setprecision(3);
+    for (const SweepRow& row : rows) {
+        os << std::setw(8) << row.n << std::setw(9) << row.nbrMoves << std::setw(7) << (row.ok ? "pass" : "FAIL")
+           << std::setw(12) << row.solveSeconds * 1e3 << std::setw(12) << row.verifySeconds * 1e3;
+        if (!row.ok) os << "  " << row.error;
+        os << '\n';
+        nbrFailures += !row.ok;
+        solveSeconds += row.solveSeconds;
+        verifySeconds += row.verifySeconds;
+    }
+    os << "Sweep | " << rows.size() << " values of n, " << rows.size() - nbrFailures << " passed, " << nbrFailures
+       << " failed, solve " << solveSeconds << " s, verify " << verifySeconds << " s (summed over threads)" << std::endl;
+    os << std::defaultfloat;
+    return nbrFailures;
+}
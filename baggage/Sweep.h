@@ -0,0 +1,24 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* Solves every n in [nMin, nMax] on 'nbrThreads' threads (0: hardware concurrency) and checks each
+ * move list with verifyMoves. Each thread solves with its own Data instance, the next n is taken
+ * from a shared counter.
+ */
+struct SweepRow {
+    int n;
+    int nbrMoves;
+    bool ok;            // the moves pass verifyMoves
+    std::string error;  // of verifyMoves
+    double solveSeconds;
+    double verifySeconds;
+};
+
+std::vector<SweepRow> runSweep(int nMin, int nMax, int nbrThreads, bool closedForm);
+    /// closedForm: closedFormMoves instead of the simulating solver
+
+/// one line per n, failures are explained, followed by a summary line. Returns the number of failures
+int printSweep(const std::vector<SweepRow>& rows, std::ostream& os);
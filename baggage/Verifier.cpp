@@ -0,0 +1,54 @@
+#include "Verifier.h"
+#include "PackedLine.h"
+
+#include <cassert>
+
+namespace {
+
+std::string describe(int moveNbr, const Move& m, const std::string& what) {
+    return "move " + std::to_string(moveNbr) + " (" + std::to_string(m.from) + " to " + std::to_string(m.to) + "): " + what;
+}
+
+}
+
+VerifyResult verifyMoves(int n, const std::vector<Move>& moves) {
+    assert(n >= 3);
+    PackedLine line(-4*n, 4*n);
+    for (int idx = 1; idx <= 2*n; ++idx) {
+        line.set(idx, idx % 2 == 1 ? ElemType::B : ElemType::A);
+    }
+    int moveNbr = 0;
+    for (const Move& m : moves) {
+        ++moveNbr;
+        if (m.from < line.first() || m.from >= line.last() || m.to < line.first() || m.to >= line.last()) {
+            return {false, moveNbr, describe(moveNbr, m, "outside of the line")};
+        }
+        ElemType first = line.get(m.from), second = line.get(m.from + 1);
+        if (first == ElemType::EMPTY || second == ElemType::EMPTY) {
+            return {false, moveNbr, describe(moveNbr, m, "source is empty")};
+        }
+        // overlapping source and target are caught here as well
+        if (line.get(m.to) != ElemType::EMPTY || line.get(m.to + 1) != ElemType::EMPTY) {
+            return {false, moveNbr, describe(moveNbr, m, "target is not empty")};
+        }
+        line.set(m.from, ElemType::EMPTY);
+        line.set(m.from + 1, ElemType::EMPTY);
+        line.set(m.to, first);
+        line.set(m.to + 1, second);
+    }
+
+    // the 2n elements are still on the line: they are in order if the n cells from the
+    // leftmost element are A's and the next n cells are B's
+    int start = line.firstNonEmpty();
+    for (int i = 0; i < 2*n; ++i) {
+        if (start + i > line.last() || line.get(start + i) != (i < n ? ElemType::A : ElemType::B)) {
+            return {false, moveNbr, "final line is not " + std::to_string(n) + " A's followed by "
+                                    + std::to_string(n) + " B's (cell " + std::to_string(start + i) + ")"};
+        }
+    }
+    // fewer than n moves cannot sort the line, so n is the minimum
+    if (moveNbr != n) {
+        return {false, moveNbr, std::to_string(moveNbr) + " moves instead of the minimum " + std::to_string(n)};
+    }
+    return {true, moveNbr, ""};
+}
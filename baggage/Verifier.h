@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Move.h"
+
+#include <string>
+#include <vector>
+
+/* Replays moves on a packed line of n pairs BABA...BA at indices 1 to 2n (n >= 3).
+ * Every move must take two non-empty cells to two empty cells (the preconditions of Data::move),
+ * afterwards the pairs must form AA...ABB...B (n A's, then n B's) anywhere on the line,
+ * with exactly n moves (the minimum).
+ * Cells in [-4n, 4n] can be used, moves outside of it are rejected.
+ */
+struct VerifyResult {
+    bool ok;
+    int nbrMoves;       // moves replayed (up to and including the failing one)
+    std::string error;  // empty if ok
+};
+
+VerifyResult verifyMoves(int n, const std::vector<Move>& moves);
@@ -0,0 +1,40 @@
+#include "Move.h"
+#include "Verifier.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+/// Checks a move list for n pairs, e.g. echo 1001 | ./orderBaggage | ./verifyBaggage 1001
+// usage: verifyBaggage n [movesFile] (moves are read from stdin if no file is given)
+// exit code 0: valid solution, 1: invalid solution, 2: bad usage or input
+int main(int argc, char** argv) {
+    if (argc < 2 || std::atoi(argv[1]) < 3) {
+        std::cerr << "usage: verifyBaggage n [movesFile] (n >= 3)" << std::endl;
+        return 2;
+    }
+    int n = std::atoi(argv[1]);
+    FILE* in = stdin;
+    if (argc > 2 && !(in = std::fopen(argv[2], "r"))) {
+        std::cerr << "Error: cannot open " << argv[2] << std::endl;
+        return 2;
+    }
+    MoveReader reader(in);
+    std::vector<Move> moves = reader.readAll();
+    if (reader.malformed()) {
+        std::cerr << "Error: malformed move after move " << moves.size() << std::endl;
+        return 2;
+    }
+
+    auto t = std::chrono::steady_clock::now();
+    VerifyResult result = verifyMoves(n, moves);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+    if (result.ok) {
+        std::cout << "OK: " << moves.size() << " moves for n = " << n;
+    } else {
+        std::cout << "FAIL: " << result.error;
+    }
+    std::cout << " (replayed in " << seconds * 1e3 << " ms)" << std::endl;
+    return result.ok ? 0 : 1;
+}